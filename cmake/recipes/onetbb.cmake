@@ -0,0 +1,36 @@
+#
+# Copyright 2021 Adobe. All rights reserved.
+# This file is licensed to you under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License. You may obtain a copy
+# of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under
+# the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+# OF ANY KIND, either express or implied. See the License for the specific language
+# governing permissions and limitations under the License.
+#
+
+# oneTBB (https://github.com/oneapi-src/oneTBB)
+# License: Apache-2.0
+
+if(TARGET TBB::tbb)
+    return()
+endif()
+
+message(STATUS "Third-party (external): creating target 'TBB::tbb'")
+
+# We only need the core tbb library, skip the allocator, tests and examples
+set(TBB_TEST OFF CACHE BOOL "" FORCE)
+set(TBB_EXAMPLES OFF CACHE BOOL "" FORCE)
+set(TBB_STRICT OFF CACHE BOOL "" FORCE)
+set(TBBMALLOC_BUILD OFF CACHE BOOL "" FORCE)
+set(TBBMALLOC_PROXY_BUILD OFF CACHE BOOL "" FORCE)
+
+include(CPM)
+CPMAddPackage(
+    NAME tbb
+    GITHUB_REPOSITORY oneapi-src/oneTBB
+    GIT_TAG v2021.9.0
+)
+
+set_target_properties(tbb PROPERTIES FOLDER third_party)
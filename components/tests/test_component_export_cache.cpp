@@ -35,4 +35,39 @@ TEST_CASE("component_export_cache", "[components][export_cache]")
 
         CHECK_NOTHROW(wmtk::components::export_cache(Paths(), o, cache));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("component_export_cache_compressed", "[components][export_cache]")
+{
+    wmtk::io::Cache cache("wmtk_cache", ".");
+
+    // input
+    {
+        const std::filesystem::path input_file = data_dir / "small.msh";
+        json component_json = {
+            {"name", "input_mesh"},
+            {"file", input_file.string()},
+            {"ignore_z", false},
+            {"tetrahedron_attributes", json::array()}};
+
+
+        CHECK_NOTHROW(wmtk::components::input(Paths(), component_json, cache));
+    }
+
+    wmtk::io::Cache cache_dump("wmtk_dump", ".");
+    const std::filesystem::path export_location = cache_dump.get_cache_path() / "exported_cache";
+
+    // export cache
+    {
+        json o;
+        o["folder"] = export_location;
+        o["chunk_size"] = 64;
+        o["compression_level"] = 9;
+
+        CHECK_NOTHROW(wmtk::components::export_cache(Paths(), o, cache));
+    }
+
+    wmtk::io::Cache imported("wmtk_import", ".");
+    REQUIRE(imported.import_cache(export_location));
+    CHECK(*imported.read_mesh("input_mesh") == *cache.read_mesh("input_mesh"));
+}
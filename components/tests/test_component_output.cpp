@@ -3,6 +3,7 @@
 #include <wmtk/components/base/Paths.hpp>
 #include <wmtk/components/input/input.hpp>
 #include <wmtk/components/output/output.hpp>
+#include <wmtk/io/MeshReader.hpp>
 
 using namespace wmtk::components::base;
 
@@ -36,6 +37,22 @@ TEST_CASE("component_output", "[components][output]")
         CHECK_NOTHROW(wmtk::components::output(Paths(), component_json, cache));
     }
 
+    SECTION("hdf5")
+    {
+        json component_json = R"({
+            "input": "input_mesh",
+            "attributes": {"position": "vertices"},
+            "file": "bunny.hdf5",
+            "chunk_size": 1024,
+            "compression_level": 4
+        })"_json;
+
+        CHECK_NOTHROW(wmtk::components::output(Paths(), component_json, cache));
+
+        auto mesh = wmtk::read_mesh("bunny.hdf5");
+        CHECK(*mesh == *cache.read_mesh("input_mesh"));
+    }
+
     SECTION("should throw")
     {
         json component_json = R"({
@@ -5,6 +5,18 @@
 #include <wmtk/io/Cache.hpp>
 #include <wmtk/io/ParaviewWriter.hpp>
 
+#include <random>
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/TriMesh.hpp>
+#include <wmtk/components/procedural/internal/DiskOptions.hpp>
+#include <wmtk/components/procedural/internal/Grid2Options.hpp>
+#include <wmtk/components/procedural/internal/Grid3Options.hpp>
+#include <wmtk/components/procedural/internal/TriangleFanOptions.hpp>
+#include <wmtk/components/procedural/internal/make_mesh.hpp>
+#include <wmtk/invariants/MultiMeshLinkConditionInvariant.hpp>
+#include <wmtk/operations/EdgeCollapse.hpp>
+#include <wmtk/simplex/link_condition.hpp>
+
 using namespace wmtk::components::base;
 using json = nlohmann::json;
 
@@ -162,3 +174,77 @@ TEST_CASE("component_procedural_cyclic_grids", "[components][procedural]")
         CHECK_NOTHROW(wmtk::components::procedural(Paths(), component_json, cache));
     }
 }
+
+namespace {
+// compares the fast link condition against the link intersection reference on all edges while
+// randomly collapsing edges of the mesh
+template <typename MeshType>
+void check_link_condition_equivalence(MeshType& m, int64_t n_collapses)
+{
+    std::mt19937 gen(42);
+
+    auto check_all_edges = [&m]() {
+        for (const wmtk::Tuple& e : m.get_all(wmtk::PrimitiveType::Edge)) {
+            CHECK(
+                wmtk::simplex::link_condition(m, e) ==
+                wmtk::simplex::link_condition_from_links(m, e));
+        }
+    };
+
+    wmtk::operations::EdgeCollapse op(m);
+    op.add_invariant(std::make_shared<wmtk::MultiMeshLinkConditionInvariant>(m));
+
+    check_all_edges();
+    for (int64_t j = 0; j < n_collapses; ++j) {
+        const std::vector<wmtk::Tuple> edges = m.get_all(wmtk::PrimitiveType::Edge);
+        if (edges.empty()) {
+            break;
+        }
+        std::uniform_int_distribution<size_t> dist(0, edges.size() - 1);
+        op(wmtk::simplex::Simplex::edge(edges[dist(gen)]));
+        check_all_edges();
+    }
+}
+} // namespace
+
+TEST_CASE("component_procedural_link_condition", "[components][procedural][link_condition]")
+{
+    using namespace wmtk::components::internal;
+
+    SECTION("grid2")
+    {
+        for (const bool cyclic : {false, true}) {
+            Grid2Options opts;
+            opts.tiling_type = Grid2Options::TilingType::Diagonal;
+            opts.dimensions = {{5, 5}};
+            opts.cycles = cyclic ? 0b11 : 0b00;
+            auto mesh = procedural::make_mesh(opts);
+            check_link_condition_equivalence(static_cast<wmtk::TriMesh&>(*mesh), 40);
+        }
+    }
+    SECTION("grid3")
+    {
+        for (const bool cyclic : {false, true}) {
+            Grid3Options opts;
+            opts.tiling_type = Grid3Options::TilingType::Freudenthal;
+            opts.dimensions = {{3, 3, 3}};
+            opts.cycles = cyclic ? 0b111 : 0b000;
+            auto mesh = procedural::make_mesh(opts);
+            check_link_condition_equivalence(static_cast<wmtk::TetMesh&>(*mesh), 40);
+        }
+    }
+    SECTION("disk")
+    {
+        DiskOptions opts;
+        opts.size = 10;
+        auto mesh = procedural::make_mesh(opts);
+        check_link_condition_equivalence(static_cast<wmtk::TriMesh&>(*mesh), 10);
+    }
+    SECTION("triangle_fan")
+    {
+        TriangleFanOptions opts;
+        opts.size = 10;
+        auto mesh = procedural::make_mesh(opts);
+        check_link_condition_equivalence(static_cast<wmtk::TriMesh&>(*mesh), 10);
+    }
+}
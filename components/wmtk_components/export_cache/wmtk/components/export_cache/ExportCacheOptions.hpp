@@ -11,9 +11,24 @@ namespace internal {
 struct ExportCacheOptions
 {
     std::filesystem::path folder;
+    int64_t chunk_size = 0;
+    int compression_level = 0;
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ExportCacheOptions, folder);
+inline void to_json(nlohmann::json& j, const ExportCacheOptions& o)
+{
+    j["folder"] = o.folder;
+    j["chunk_size"] = o.chunk_size;
+    j["compression_level"] = o.compression_level;
+}
+
+// the hdf5 options are optional
+inline void from_json(const nlohmann::json& j, ExportCacheOptions& o)
+{
+    o.folder = j.at("folder").get<std::filesystem::path>();
+    o.chunk_size = j.value("chunk_size", int64_t(0));
+    o.compression_level = j.value("compression_level", 0);
+}
 
 } // namespace internal
 } // namespace components
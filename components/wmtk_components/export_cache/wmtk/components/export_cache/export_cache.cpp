@@ -20,7 +20,18 @@ void export_cache(const base::Paths& paths, const nlohmann::json& j, io::Cache&
         log_and_throw_error("Cannot export cache, folder {} already exists", export_location);
     }
 
-    if (!cache.export_cache(export_location)) {
+    bool exported = false;
+    if (options.chunk_size == 0 && options.compression_level == 0) {
+        exported = cache.export_cache(export_location);
+    } else {
+        // the meshes are written again with the requested dataset options
+        HDF5WriterOptions writer_options;
+        writer_options.chunk_size = options.chunk_size;
+        writer_options.compression_level = options.compression_level;
+        exported = cache.export_cache(export_location, writer_options);
+    }
+
+    if (!exported) {
         log_and_throw_error("Could not export cache from {}", export_location);
     }
 }
@@ -35,7 +35,8 @@ void isotropic_remeshing(
     const int64_t iterations,
     const std::vector<attribute::MeshAttributeHandle>& other_positions,
     bool update_other_positions,
-    const std::optional<attribute::MeshAttributeHandle>& position_for_inversion)
+    const std::optional<attribute::MeshAttributeHandle>& position_for_inversion,
+    bool incremental_consolidation)
 {
     assert(dynamic_cast<TriMesh*>(&position.mesh()) != nullptr);
 
@@ -236,7 +237,12 @@ void isotropic_remeshing(
             pass_stats += scheduler.run_operation_on_all(*op);
         }
 
-        multimesh::consolidate(mesh);
+        if (incremental_consolidation) {
+            // only the simplices deleted by this pass are compacted, the order is not kept
+            multimesh::consolidate_incremental(mesh);
+        } else {
+            multimesh::consolidate(mesh);
+        }
 
         logger().info(
             "Executed {} ops (S/F) {}/{}. Time: collecting: {}, sorting: {}, executing: {}",
@@ -246,8 +252,6 @@ void isotropic_remeshing(
             pass_stats.collecting_time,
             pass_stats.sorting_time,
             pass_stats.executing_time);
-
-        multimesh::consolidate(mesh);
     }
 }
 
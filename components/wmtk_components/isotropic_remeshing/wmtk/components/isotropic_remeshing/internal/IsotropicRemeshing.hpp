@@ -22,6 +22,7 @@ void isotropic_remeshing(
     const int64_t iterations,
     const std::vector<attribute::MeshAttributeHandle>& other_positions = {},
     bool update_other_positions = false,
-    const std::optional<attribute::MeshAttributeHandle>& position_for_inversion = {});
+    const std::optional<attribute::MeshAttributeHandle>& position_for_inversion = {},
+    bool incremental_consolidation = false);
 
 } // namespace wmtk::components::internal
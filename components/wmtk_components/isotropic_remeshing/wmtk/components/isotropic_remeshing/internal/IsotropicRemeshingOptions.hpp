@@ -32,6 +32,7 @@ struct IsotropicRemeshingOptions
     bool use_for_periodic;
     bool dont_disable_split;
     bool fix_uv_seam;
+    bool incremental_consolidation;
 };
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
@@ -45,6 +46,7 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
     iterations,
     lock_boundary,
     use_for_periodic,
-    dont_disable_split);
+    dont_disable_split,
+    incremental_consolidation);
 
 } // namespace wmtk::components::internal
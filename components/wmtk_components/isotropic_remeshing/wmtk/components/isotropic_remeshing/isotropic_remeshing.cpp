@@ -95,7 +95,8 @@ void isotropic_remeshing(const base::Paths& paths, const nlohmann::json& j, io::
         options.iterations,
         other_positions,
         options.attributes.update_other_positions,
-        position_for_inversion);
+        position_for_inversion,
+        options.incremental_consolidation);
 
     // output
     cache.write_mesh(*mesh_in, options.output);
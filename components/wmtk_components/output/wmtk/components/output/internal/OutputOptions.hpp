@@ -20,9 +20,28 @@ struct OutputOptions
     std::string input;
     std::filesystem::path file;
     OutputAttributes attributes;
+    int64_t chunk_size = 0;
+    int compression_level = 0;
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(OutputOptions, input, file, attributes);
+inline void to_json(nlohmann::json& j, const OutputOptions& o)
+{
+    j["input"] = o.input;
+    j["file"] = o.file;
+    j["attributes"] = o.attributes;
+    j["chunk_size"] = o.chunk_size;
+    j["compression_level"] = o.compression_level;
+}
+
+// the hdf5 options are optional
+inline void from_json(const nlohmann::json& j, OutputOptions& o)
+{
+    o.input = j.at("input").get<std::string>();
+    o.file = j.at("file").get<std::filesystem::path>();
+    o.attributes = j.at("attributes").get<OutputAttributes>();
+    o.chunk_size = j.value("chunk_size", int64_t(0));
+    o.compression_level = j.value("compression_level", 0);
+}
 
 } // namespace internal
 } // namespace components
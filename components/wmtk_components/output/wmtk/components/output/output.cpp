@@ -2,6 +2,7 @@
 
 #include <wmtk/Mesh.hpp>
 #include <wmtk/components/base/resolve_path.hpp>
+#include <wmtk/io/HDF5Writer.hpp>
 #include <wmtk/io/ParaviewWriter.hpp>
 #include <wmtk/utils/Logger.hpp>
 
@@ -31,6 +32,13 @@ void output(const base::Paths& paths, const nlohmann::json& j, io::Cache& cache)
         ParaviewWriter
             writer(file, options.attributes.position, *mesh, out[0], out[1], out[2], out[3]);
         mesh->serialize(writer);
+    } else if (file.extension() == ".hdf5") {
+        wmtk::logger().info("Saving on {}", file.string());
+        HDF5WriterOptions writer_options;
+        writer_options.chunk_size = options.chunk_size;
+        writer_options.compression_level = options.compression_level;
+        HDF5Writer writer(file, writer_options);
+        mesh->serialize(writer);
     } else {
         throw std::runtime_error(std::string("Unknown file type: ") + file.string());
     }
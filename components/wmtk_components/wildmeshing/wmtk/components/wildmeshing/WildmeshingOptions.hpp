@@ -41,6 +41,7 @@ public:
     int64_t passes;
     double target_edge_length;
     bool intermediate_output;
+    bool until_convergence;
 };
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
@@ -52,6 +53,7 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
     envelopes,
     target_edge_length,
     intermediate_output,
+    until_convergence,
     output);
 
 } // namespace wmtk::components
@@ -8,6 +8,7 @@
 #include <wmtk/TriMesh.hpp>
 
 #include <wmtk/components/base/get_attributes.hpp>
+#include <wmtk/envelope/EnvelopeIndex.hpp>
 #include <wmtk/multimesh/consolidate.hpp>
 #include <wmtk/utils/Logger.hpp>
 
@@ -50,6 +51,7 @@
 #include <wmtk/io/MeshReader.hpp>
 #include <wmtk/io/ParaviewWriter.hpp>
 
+#include <set>
 
 namespace wmtk::components {
 
@@ -81,8 +83,9 @@ void write(
                 true,
                 true,
                 true,
-                false);
-            mesh->serialize(writer);
+                false,
+                true);
+            mesh->serialize_consolidated(writer);
         } else if (mesh->top_simplex_type() == PrimitiveType::Tetrahedron) {
             // write tetmesh
             const std::filesystem::path data_dir = "";
@@ -93,8 +96,9 @@ void write(
                 true,
                 true,
                 true,
+                true,
                 true);
-            mesh->serialize(writer);
+            mesh->serialize_consolidated(writer);
         } else if (mesh->top_simplex_type() == PrimitiveType::Edge) {
             // write edgemesh
             const std::filesystem::path data_dir = "";
@@ -105,8 +109,9 @@ void write(
                 true,
                 true,
                 false,
-                false);
-            mesh->serialize(writer);
+                false,
+                true);
+            mesh->serialize_consolidated(writer);
         }
     }
 }
@@ -179,13 +184,13 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
     //////////////////////////////////
     // Lambdas for priority
     //////////////////////////////////
-    auto long_edges_first = [&](const simplex::Simplex& s) {
+    auto long_edges_first = [&](const simplex::Simplex& s) -> operations::PriorityKey {
         assert(s.primitive_type() == PrimitiveType::Edge);
-        return std::vector<double>({-edge_length_accessor.scalar_attribute(s.tuple())});
+        return -edge_length_accessor.scalar_attribute(s.tuple());
     };
-    auto short_edges_first = [&](const simplex::Simplex& s) {
+    auto short_edges_first = [&](const simplex::Simplex& s) -> operations::PriorityKey {
         assert(s.primitive_type() == PrimitiveType::Edge);
-        return std::vector<double>({edge_length_accessor.scalar_attribute(s.tuple())});
+        return edge_length_accessor.scalar_attribute(s.tuple());
     };
 
 
@@ -201,13 +206,13 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
         assert(P.cols() == 1);
         return P.col(0);
     };
-    using MeshConstrainPair = ProjectOperation::MeshConstrainPair;
+    using EnvelopeConstrainPair = ProjectOperation::EnvelopeConstrainPair;
 
     auto envelope_invariant = std::make_shared<InvariantCollection>(*mesh);
     std::vector<std::shared_ptr<SingleAttributeTransferStrategy<double, double>>>
         update_child_positon, update_parent_positon;
     std::vector<std::shared_ptr<Mesh>> envelopes;
-    std::vector<MeshConstrainPair> mesh_constaint_pairs;
+    std::vector<EnvelopeConstrainPair> mesh_constaint_pairs;
 
     std::vector<std::shared_ptr<Mesh>> multimesh_meshes;
 
@@ -223,10 +228,13 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
         auto envelope_position_handle =
             envelope->get_attribute_handle<double>(v.geometry.position, PrimitiveType::Vertex);
 
-        mesh_constaint_pairs.emplace_back(envelope_position_handle, constrained.front());
+        // built once, the invariant and the projections share it
+        auto envelope_index = std::make_shared<wmtk::envelope::EnvelopeIndex>(envelope_position_handle);
+
+        mesh_constaint_pairs.emplace_back(envelope_index, constrained.front());
 
         envelope_invariant->add(std::make_shared<EnvelopeInvariant>(
-            envelope_position_handle,
+            envelope_index,
             v.thickness * bbdiag,
             constrained.front()));
 
@@ -308,6 +316,8 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
     //////////////////////////////////
     std::vector<std::shared_ptr<Operation>> ops;
     std::vector<std::string> ops_name;
+    // ops that converge on their own and are run from a priority queue
+    std::set<const Operation*> queued_ops;
 
     //////////////////////////////////
     // 1) EdgeSplit
@@ -327,6 +337,7 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
 
     ops.emplace_back(split);
     ops_name.emplace_back("split");
+    queued_ops.insert(split.get());
 
     //////////////////////////////////
     // 2) EdgeCollapse
@@ -355,6 +366,7 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
 
     ops.emplace_back(proj_collapse);
     ops_name.emplace_back("collapse");
+    queued_ops.insert(proj_collapse.get());
 
 
     //////////////////////////////////
@@ -464,10 +476,16 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
     for (int64_t i = 0; i < options.passes; ++i) {
         logger().info("Pass {}", i);
         SchedulerStats pass_stats;
+        int64_t topology_changes = 0;
         int jj = 0;
         for (auto& op : ops) {
-            auto stats = scheduler.run_operation_on_all(*op);
+            auto stats = options.until_convergence && queued_ops.count(op.get()) > 0
+                             ? scheduler.run_operation_until_convergence(*op)
+                             : scheduler.run_operation_on_all(*op);
             pass_stats += stats;
+            if (op != proj_smoothing) {
+                topology_changes += stats.number_of_successful_operations();
+            }
             logger().info(
                 "Executed {}, {} ops (S/F) {}/{}. Time: collecting: {}, sorting: {}, "
                 "executing: {}",
@@ -495,11 +513,21 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
             pass_stats.sorting_time,
             pass_stats.executing_time);
 
+        // the snapshot skips the deleted simplices on its own and does not touch the mesh
+        write(
+            mesh,
+            paths.output_dir,
+            options.output,
+            options.attributes.position,
+            i + 1,
+            options.intermediate_output);
+
         // if (!mesh->is_connectivity_valid()) {
         //     std::cout << "invalid connectivity before consolidate" << std::endl;
         //     throw std::runtime_error("input mesh for wildmeshing connectivity invalid");
         // }
 
+        // compacts the ids, the next pass then visits the simplices in the same order as before
         multimesh::consolidate(*mesh);
 
         // if (!mesh->is_connectivity_valid()) {
@@ -507,15 +535,12 @@ void wildmeshing(const base::Paths& paths, const nlohmann::json& j, io::Cache& c
         //     throw std::runtime_error("input mesh for wildmeshing connectivity invalid");
         // }
 
-        write(
-            mesh,
-            paths.output_dir,
-            options.output,
-            options.attributes.position,
-            i + 1,
-            options.intermediate_output);
-
         assert(mesh->is_connectivity_valid());
+
+        if (options.until_convergence && topology_changes == 0) {
+            logger().info("Converged after {} passes", i + 1);
+            break;
+        }
     }
 
 
@@ -75,7 +75,7 @@ Tuple EdgeMesh::switch_tuple(const Tuple& tuple, PrimitiveType type) const
         }
         assert(lvid_new != -1);
 
-        const attribute::Accessor<int64_t> hash_accessor = get_const_cell_hash_accessor();
+        const attribute::Accessor<int64_t>& hash_accessor = get_const_cell_hash_accessor();
 
         const Tuple res(
             lvid_new,
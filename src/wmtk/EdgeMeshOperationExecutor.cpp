@@ -39,10 +39,18 @@ EdgeMesh::EdgeMeshOperationExecutor::EdgeMeshOperationExecutor(
 
 void EdgeMesh::EdgeMeshOperationExecutor::delete_simplices()
 {
+    std::vector<int64_t> deleted_ids;
     for (size_t d = 0; d < simplex_ids_to_delete.size(); ++d) {
+        deleted_ids.clear();
         for (const int64_t id : simplex_ids_to_delete[d]) {
-            flag_accessors[d].index_access().scalar_attribute(id) = 0;
+            char& flag = flag_accessors[d].index_access().scalar_attribute(id);
+            // ids that are listed twice must only be handed out once
+            if (flag & 0x1) {
+                deleted_ids.emplace_back(id);
+            }
+            flag = 0;
         }
+        m_mesh.release_simplex_indices(get_primitive_type_from_id(d), deleted_ids);
     }
 }
 
@@ -235,7 +243,6 @@ std::vector<int64_t> EdgeMesh::EdgeMeshOperationExecutor::request_simplex_indice
     const PrimitiveType type,
     int64_t count)
 {
-    m_mesh.guarantee_more_attributes(type, count);
     return m_mesh.request_simplex_indices(type, count);
 }
 
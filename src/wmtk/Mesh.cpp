@@ -2,6 +2,7 @@
 #include <numeric>
 
 #include <wmtk/io/MeshWriter.hpp>
+#include <wmtk/multimesh/utils/tuple_map_attribute_io.hpp>
 #include <wmtk/utils/Logger.hpp>
 #include <wmtk/utils/vector_hash.hpp>
 
@@ -42,6 +43,27 @@ std::vector<Tuple> Mesh::get_all(PrimitiveType type, const bool include_deleted)
     return ret;
 }
 
+std::vector<PackedTuple> Mesh::get_all_packed(PrimitiveType type) const
+{
+    std::vector<PackedTuple> ret;
+
+    if (static_cast<int8_t>(type) > top_cell_dimension()) return ret;
+
+    const int64_t cap = capacity(type);
+    if (cap > 0 && capacity(top_simplex_type()) - 1 > PackedTuple::max_global_cid) {
+        log_and_throw_error("Mesh is too large to pack its tuples");
+    }
+
+    const attribute::Accessor<char> flag_accessor = get_flag_accessor(type);
+    const attribute::CachingAccessor<char>& flag_accessor_indices = flag_accessor.index_access();
+    ret.reserve(cap);
+    for (int64_t index = 0; index < cap; ++index) {
+        if (flag_accessor_indices.const_scalar_attribute(index) & 1)
+            ret.emplace_back(tuple_from_id(type, index));
+    }
+    return ret;
+}
+
 void Mesh::serialize(MeshWriter& writer, const Mesh* local_root) const
 {
     if (local_root == nullptr) {
@@ -55,6 +77,94 @@ void Mesh::serialize(MeshWriter& writer, const Mesh* local_root) const
     m_multi_mesh_manager.serialize(writer, local_root);
 }
 
+void Mesh::serialize_consolidated(MeshWriter& writer, const Mesh* local_root) const
+{
+    const auto [new2old, old2new] = consolidation_maps();
+
+    std::vector<int64_t> parent_top_old2new;
+    const Mesh* parent_ptr = m_multi_mesh_manager.m_parent;
+    if (parent_ptr != nullptr) {
+        auto parent_maps = parent_ptr->consolidation_maps();
+        parent_top_old2new = std::move(
+            std::get<1>(parent_maps)[get_primitive_type_id(parent_ptr->top_simplex_type())]);
+    }
+
+    serialize_consolidated(
+        writer,
+        local_root,
+        new2old,
+        old2new,
+        parent_ptr == nullptr ? nullptr : &parent_top_old2new);
+}
+
+void Mesh::serialize_consolidated(
+    MeshWriter& writer,
+    const Mesh* local_root,
+    const std::vector<std::vector<int64_t>>& new2old,
+    const std::vector<std::vector<int64_t>>& old2new,
+    const std::vector<int64_t>* parent_top_old2new) const
+{
+    if (local_root == nullptr) {
+        writer.write_absolute_id(m_multi_mesh_manager.absolute_id());
+    } else {
+        writer.write_absolute_id(m_multi_mesh_manager.relative_id(*this, *local_root));
+    }
+    writer.write_top_simplex_type(top_simplex_type());
+
+    using ColumnMaps = std::vector<const std::vector<int64_t>*>;
+    std::vector<std::map<attribute::AttributeHandle, ColumnMaps>> index_remaps(
+        top_cell_dimension() + 1);
+
+    // connectivity attributes store indices of the simplices of dimension d in every column
+    const std::vector<std::vector<TypedAttributeHandle<int64_t>>> handle_indices =
+        connectivity_attributes();
+    for (int64_t d = 0; d < handle_indices.size(); ++d) {
+        for (const auto& handle : handle_indices[d]) {
+            index_remaps[get_primitive_type_id(handle.primitive_type())][handle.base_handle()] =
+                ColumnMaps(get_attribute_dimension(handle), &old2new[d]);
+        }
+    }
+
+    // multimesh maps store a tuple of this mesh and one of the other mesh, see consolidate
+    constexpr static int64_t TUPLE_SIZE = multimesh::utils::TUPLE_SIZE; // in terms of int64_t
+    constexpr static int64_t GLOBAL_ID_INDEX = multimesh::utils::GLOBAL_ID_INDEX;
+    const std::vector<int64_t>& top_map = old2new[get_primitive_type_id(top_simplex_type())];
+    auto add_map_remap = [&](const TypedAttributeHandle<int64_t>& handle,
+                             const std::vector<int64_t>& image_map) {
+        ColumnMaps maps(get_attribute_dimension(handle), nullptr);
+        maps[GLOBAL_ID_INDEX] = &top_map;
+        maps[TUPLE_SIZE + GLOBAL_ID_INDEX] = &image_map;
+        index_remaps[get_primitive_type_id(handle.primitive_type())][handle.base_handle()] =
+            std::move(maps);
+    };
+
+    if (parent_top_old2new != nullptr) {
+        add_map_remap(m_multi_mesh_manager.map_to_parent_handle, *parent_top_old2new);
+    }
+
+    const auto& children = m_multi_mesh_manager.m_children;
+    std::vector<std::vector<std::vector<int64_t>>> children_new2old(children.size());
+    std::vector<std::vector<std::vector<int64_t>>> children_old2new(children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+        const Mesh& child = *children[i].mesh;
+        std::tie(children_new2old[i], children_old2new[i]) = child.consolidation_maps();
+        add_map_remap(
+            children[i].map_handle,
+            children_old2new[i][get_primitive_type_id(child.top_simplex_type())]);
+    }
+
+    m_attribute_manager.serialize_consolidated(writer, new2old, index_remaps);
+
+    for (size_t i = 0; i < children.size(); ++i) {
+        children[i].mesh->serialize_consolidated(
+            writer,
+            local_root,
+            children_new2old[i],
+            children_old2new[i],
+            &top_map);
+    }
+}
+
 
 bool Mesh::is_boundary(const simplex::Simplex& s) const
 {
@@ -77,10 +187,42 @@ bool Mesh::is_hash_valid(const Tuple& tuple, const attribute::Accessor<int64_t>&
 
 bool Mesh::is_valid_slow(const Tuple& tuple) const
 {
-    const attribute::Accessor<int64_t> hash_accessor = get_const_cell_hash_accessor();
-    return is_valid(tuple, hash_accessor);
+    return is_valid(tuple, get_const_cell_hash_accessor());
+}
+
+bool Mesh::is_valid_current(const Tuple& tuple) const
+{
+    if (tuple.is_null()) {
+        return false;
+    }
+    const attribute::Attribute<int64_t>& hashes = get_const_cell_hash_accessor().attribute();
+    return tuple.m_hash == hashes.const_scalar_attribute(tuple.m_global_cid);
 }
 
+int64_t Mesh::validate_tuples(std::vector<Tuple>& tuples, bool resurrect) const
+{
+    const attribute::Attribute<int64_t>& hashes = get_const_cell_hash_accessor().attribute();
+    const attribute::Accessor<char> flag_accessor = get_const_flag_accessor(top_simplex_type());
+    const attribute::Attribute<char>& flags = flag_accessor.attribute();
+
+    int64_t resurrected = 0;
+    size_t kept = 0;
+    for (const Tuple& t : tuples) {
+        if (t.is_null()) {
+            continue;
+        }
+        const int64_t hash = hashes.const_scalar_attribute(t.m_global_cid);
+        if (t.m_hash == hash) {
+            tuples[kept++] = t;
+        } else if (resurrect && (flags.const_scalar_attribute(t.m_global_cid) & 1)) {
+            tuples[kept] = t;
+            tuples[kept++].m_hash = hash;
+            ++resurrected;
+        }
+    }
+    tuples.resize(kept);
+    return resurrected;
+}
 
 const attribute::Accessor<char> Mesh::get_flag_accessor(PrimitiveType type) const
 {
@@ -95,12 +237,13 @@ attribute::Accessor<char> Mesh::get_flag_accessor(PrimitiveType type)
     return create_accessor(m_flag_handles.at(get_primitive_type_id(type)));
 }
 
-const attribute::Accessor<int64_t> Mesh::get_const_cell_hash_accessor() const
+const attribute::Accessor<int64_t>& Mesh::get_const_cell_hash_accessor() const
 {
-    return create_const_accessor(m_cell_hash_handle);
+    assert(bool(m_cell_hash_accessor));
+    return *m_cell_hash_accessor;
 }
 
-const attribute::Accessor<int64_t> Mesh::get_cell_hash_accessor() const
+const attribute::Accessor<int64_t>& Mesh::get_cell_hash_accessor() const
 {
     return get_const_cell_hash_accessor();
 }
@@ -166,8 +309,7 @@ int64_t Mesh::get_cell_hash(int64_t cell_index, const attribute::Accessor<int64_
 
 int64_t Mesh::get_cell_hash_slow(int64_t cell_index) const
 {
-    const attribute::Accessor<int64_t> hash_accessor = get_cell_hash_accessor();
-    return get_cell_hash(cell_index, hash_accessor);
+    return get_cell_hash(cell_index, get_const_cell_hash_accessor());
 }
 
 void Mesh::set_capacities_from_flags()
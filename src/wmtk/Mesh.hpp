@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <array>
 
 #include <initializer_list>
 
@@ -18,6 +19,7 @@
 
 // basic data for the class
 #include <wmtk/simplex/Simplex.hpp>
+#include "PackedTuple.hpp"
 #include "Tuple.hpp"
 #include "Types.hpp"
 #include "attribute/Attribute.hpp" // Why do we need to include this now?
@@ -39,6 +41,7 @@
 
 
 namespace wmtk {
+class Scheduler;
 // thread management tool that we will PImpl
 namespace attribute {
 class AttributeManager;
@@ -66,6 +69,9 @@ class SimplexComparisons;
 namespace io {
 class ParaviewWriter;
 }
+namespace envelope {
+class EnvelopeIndex;
+}
 namespace multimesh {
 template <int64_t cell_dimension, typename NodeFunctor>
 class MultiMeshSimplexVisitor;
@@ -97,6 +103,7 @@ public:
     template <typename T, typename MeshType, int Dim>
     friend class attribute::Accessor;
     friend class io::ParaviewWriter;
+    friend class envelope::EnvelopeIndex;
     friend class HDF5Reader;
     friend class multimesh::attribute::UseParentScopeRAII;
     friend class multimesh::MultiMeshManager;
@@ -119,6 +126,7 @@ public:
     friend class operations::EdgeCollapse;
     friend class operations::EdgeSplit;
     friend class operations::EdgeOperationData;
+    friend class Scheduler;
 
     friend void operations::utils::update_vertex_operation_multimesh_map_hash(
         Mesh& m,
@@ -150,6 +158,14 @@ public:
     virtual ~Mesh();
 
     void serialize(MeshWriter& writer, const Mesh* local_root = nullptr) const;
+    /**
+     * @brief Serialize only the simplices that are not deleted.
+     *
+     * Indices are remapped while writing, so the output (including the child meshes) is the same as
+     * calling serialize after multimesh::consolidate. Unlike consolidate this does not modify the
+     * mesh, so it can be used for snapshots of a running session.
+     */
+    void serialize_consolidated(MeshWriter& writer, const Mesh* local_root = nullptr) const;
 
     /**
      * Generate a vector of Tuples from global vertex/edge/triangle/tetrahedron index
@@ -158,6 +174,12 @@ public:
      */
     std::vector<Tuple> get_all(PrimitiveType type) const;
 
+    /**
+     * @brief Same as get_all with the tuples packed into 8 bytes, for the large containers of
+     * candidates that are mostly shuffled, sorted and stored.
+     */
+    std::vector<PackedTuple> get_all_packed(PrimitiveType type) const;
+
     /**
      * Consolidate the attributes, moving all valid simplexes at the beginning of the corresponding
      * vector
@@ -165,6 +187,26 @@ public:
     virtual std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>>
     consolidate();
 
+    /**
+     * @brief The new2old and old2new maps per dimension that consolidate would apply.
+     * Deleted simplices are mapped to -1 in old2new.
+     */
+    std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>>
+    consolidation_maps() const;
+
+    /**
+     * @brief Consolidate by moving the last valid simplices of every dimension into the slots of
+     * the simplices deleted since the last consolidation.
+     *
+     * Only the moved simplices and the ones referring to them are touched, so the cost grows with
+     * the number of deleted simplices instead of the size of the mesh. Unlike consolidate the order
+     * of the valid simplices is not kept, and deleted simplices that were not released by an
+     * operation (e.g. ones read from a file) before the new end are left to consolidate.
+     *
+     * @return the (old id, new id) pairs of the moved simplices, per dimension
+     */
+    std::vector<std::vector<std::array<int64_t, 2>>> consolidate_incremental();
+
     /**
      * Returns a vector of vectors of attribute handles. The first index denotes the type of simplex
      * pointed by the attribute (i.e. the index type). As an example, the FV relationship points to
@@ -266,9 +308,10 @@ public:
 
 
     const attribute::Accessor<char> get_flag_accessor(PrimitiveType type) const;
-    const attribute::Accessor<int64_t> get_cell_hash_accessor() const;
+    const attribute::Accessor<int64_t>& get_cell_hash_accessor() const;
     const attribute::Accessor<char> get_const_flag_accessor(PrimitiveType type) const;
-    const attribute::Accessor<int64_t> get_const_cell_hash_accessor() const;
+    /// returns the accessor to the cell hashes that is owned by the mesh
+    const attribute::Accessor<int64_t>& get_const_cell_hash_accessor() const;
 
 
     int64_t get_cell_hash(int64_t cell_index, const attribute::Accessor<int64_t>& hash_accessor)
@@ -386,7 +429,14 @@ protected:
 
     // provides new simplices - should ONLY be called in our atomic topological operations
     // all returned simplices are active (i.e their flags say they exist)
+    // the attributes grow geometrically when they run out of room, accessors stay valid but
+    // vector_attribute maps taken before the call must be fetched again
+    // ids of deleted simplices are reused first, their attributes are reset to the default values
     [[nodiscard]] std::vector<int64_t> request_simplex_indices(PrimitiveType type, int64_t count);
+    // hands the ids of deleted simplices back to request_simplex_indices once the current scope
+    // is applied - should ONLY be called in our atomic topological operations after clearing the
+    // flags
+    void release_simplex_indices(PrimitiveType type, const std::vector<int64_t>& ids);
 
 public:
     /**
@@ -437,6 +487,11 @@ public:
      * @return int
      */
     int64_t capacity(PrimitiveType type) const;
+    /**
+     * @brief Live, allocated and reserved simplices per dimension, including the largest
+     * reservation so far. Useful to size the reservation of later runs.
+     */
+    std::vector<attribute::StorageStats> storage_stats() const;
 
     /**
      * @brief TODO this needs dimension?
@@ -480,6 +535,45 @@ public:
         const = 0;
     bool is_valid_slow(const Tuple& tuple) const;
 
+    /**
+     * @brief check the hash of a tuple against the current state of the mesh
+     *
+     * The cell hashes are per cell generation counters: operations bump the hash of every cell
+     * they modify or delete, and of every cell id they reuse. Scopes only cache the values they
+     * overwrite, so the current hashes are read from the attribute storage directly, one load
+     * that does not go through the scope stack of the calling thread. The local ids of the tuple
+     * are not checked and the result is meaningless inside of parent_scope.
+     */
+    bool is_valid_current(const Tuple& tuple) const;
+
+    /**
+     * @brief validates a batch of tuples with is_valid_current
+     *
+     * The valid tuples are moved to the front, in their original order, and the others are
+     * removed. With resurrect, a stale tuple whose cell was not deleted gets the current hash of
+     * its cell and is kept. Like resurrect_tuple, this is only correct if the caller knows the
+     * local ids still describe the same simplex, e.g. when the cells were only rehashed.
+     *
+     * @return the number of tuples that were resurrected
+     */
+    int64_t validate_tuples(std::vector<Tuple>& tuples, bool resurrect = false) const;
+
+    /**
+     * @brief true while the Scheduler runs operations concurrently on this mesh
+     *
+     * Whole mesh consistency checks (e.g. is_connectivity_valid) must be skipped in that case as
+     * they read simplices other threads are modifying.
+     */
+    bool is_accessed_concurrently() const { return m_accessed_concurrently; }
+    /**
+     * @brief Marks the mesh as accessed by several threads at once.
+     *
+     * While set, every thread caches its scoped changes in its own stacks. Otherwise accessors use
+     * the stack they were created with. Set by the Scheduler around parallel rounds, code driving
+     * its own threads must set it as well.
+     */
+    void set_accessed_concurrently(bool value);
+
 
     //============================
     // MultiMesh interface
@@ -833,6 +927,9 @@ protected: // THese are protected so unit tests can access - do not use manually
 
     int64_t m_top_cell_dimension = -1;
 
+    // set by the Scheduler while operations run concurrently
+    bool m_accessed_concurrently = false;
+
 private:
     // PImpl'd manager of per-thread update stacks
     // Every time a new access scope is requested the manager creates another level of indirection
@@ -854,6 +951,9 @@ private:
     // hashes for top level simplices (i.e cells) to identify whether tuples
     // are invalid or not
     TypedAttributeHandle<int64_t> m_cell_hash_handle;
+    // hashes are read on every tuple switch, we keep one accessor around instead of creating one
+    // per call
+    std::unique_ptr<attribute::Accessor<int64_t>> m_cell_hash_accessor;
 
 
     /**
@@ -863,6 +963,23 @@ private:
      * @return vector of Tuples referring to each type
      */
     std::vector<Tuple> get_all(PrimitiveType type, const bool include_deleted) const;
+
+    /**
+     * @brief Resets all attributes of the given simplices to their default values, except for the
+     * flags and the cell hashes. Used for simplices whose ids are reused.
+     */
+    void reset_simplex_attributes(PrimitiveType type, const std::vector<int64_t>& ids);
+
+    /**
+     * @brief serialize_consolidated with the consolidation maps of this mesh precomputed.
+     * parent_top_old2new is the old2new map of the top simplices of the parent mesh (if any).
+     */
+    void serialize_consolidated(
+        MeshWriter& writer,
+        const Mesh* local_root,
+        const std::vector<std::vector<int64_t>>& new2old,
+        const std::vector<std::vector<int64_t>>& old2new,
+        const std::vector<int64_t>* parent_top_old2new) const;
 };
 
 
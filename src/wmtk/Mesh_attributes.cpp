@@ -1,12 +1,16 @@
+#include <algorithm>
+#include <mutex>
 #include <numeric>
 #include "Mesh.hpp"
 
 #include <wmtk/multimesh/utils/tuple_map_attribute_io.hpp>
+#include <wmtk/simplex/top_dimension_cofaces.hpp>
 #include <wmtk/utils/Logger.hpp>
 
 #include "Primitive.hpp"
 
 namespace wmtk {
+
 template <typename T>
 attribute::MeshAttributeHandle Mesh::register_attribute(
     const std::string& name,
@@ -36,32 +40,46 @@ attribute::TypedAttributeHandle<T> Mesh::register_attribute_typed(
 
 std::vector<int64_t> Mesh::request_simplex_indices(PrimitiveType type, int64_t count)
 {
-    // passses back a set of new consecutive ids. in hte future this could do
-    // something smarter for re-use but that's probably too much work
+    // passses back ids of deleted simplices first, then a set of new consecutive ids
+    std::lock_guard<std::mutex> lock(*m_attribute_manager.m_allocation_mutex);
+    const size_t primitive_id = get_primitive_type_id(type);
     int64_t current_capacity = capacity(type);
 
+    const int64_t reused_count =
+        std::min(count, m_attribute_manager.m_free_ids.size(primitive_id));
+    const int64_t new_count = count - reused_count;
+
+    // grows the storage if needed, this reallocates the attributes so maps into them that were
+    // obtained before are invalid afterwards
+    if (current_capacity + new_count > m_attribute_manager.reserved_size(primitive_id)) {
+        // other threads might be reading, parallel rounds reserve up front
+        if (m_accessed_concurrently) {
+            log_and_throw_error(
+                "Cannot grow the {} storage beyond {} while the mesh is accessed concurrently",
+                primitive_type_name(type),
+                m_attribute_manager.reserved_size(primitive_id));
+        }
+        m_attribute_manager.guarantee_at_least_attributes(
+            primitive_id,
+            current_capacity + new_count);
+    }
+
     // enable newly requested simplices
     attribute::Accessor<char> flag_accessor = get_flag_accessor(type);
-    int64_t max_size = flag_accessor.reserved_size();
-
-    if (current_capacity + count > max_size) {
-        logger().warn(
-            "Requested more {} simplices than available (have {}, wanted {}, can only have at most "
-            "{}",
-            primitive_type_name(type),
-            current_capacity,
-            count,
-            max_size);
-        return {};
-    }
 
     std::vector<int64_t> ret(count);
-    std::iota(ret.begin(), ret.end(), current_capacity);
+    for (int64_t j = 0; j < reused_count; ++j) {
+        ret[j] = m_attribute_manager.m_free_ids.take(primitive_id);
+        assert(ret[j] >= 0 && ret[j] < current_capacity);
+    }
+    std::iota(ret.begin() + reused_count, ret.end(), current_capacity);
+    for (int64_t j = reused_count; j < count; ++j) {
+        m_attribute_manager.m_free_ids.track_new(primitive_id, ret[j]);
+    }
 
 
-    int64_t new_capacity = current_capacity + ret.size();
-    assert(ret.back() + 1 == current_capacity + ret.size());
-    size_t primitive_id = get_primitive_type_id(type);
+    int64_t new_capacity = current_capacity + new_count;
+    assert(new_count == 0 || ret.back() + 1 == new_capacity);
 
     m_attribute_manager.m_capacities[primitive_id] = new_capacity;
 
@@ -71,14 +89,93 @@ std::vector<int64_t> Mesh::request_simplex_indices(PrimitiveType type, int64_t c
         flag_accessor_indices.scalar_attribute(simplex_index) |= 0x1;
     }
 
+    if (reused_count > 0) {
+        // reused slots still hold the data of the deleted simplices
+        const std::vector<int64_t> reused(ret.begin(), ret.begin() + reused_count);
+        reset_simplex_attributes(type, reused);
+
+        // tuples pointing to the deleted cells must not become valid again
+        if (type == top_simplex_type()) {
+            attribute::Accessor<int64_t> hash_accessor = get_cell_hash_accessor();
+            update_cell_hashes(reused, hash_accessor);
+        }
+    }
+
     return ret;
 }
 
+void Mesh::set_accessed_concurrently(bool value)
+{
+    m_accessed_concurrently = value;
+    m_attribute_manager.set_accessed_concurrently(value);
+}
+
+void Mesh::release_simplex_indices(PrimitiveType type, const std::vector<int64_t>& ids)
+{
+    const size_t primitive_id = get_primitive_type_id(type);
+    for (const int64_t id : ids) {
+        m_attribute_manager.m_free_ids.release(primitive_id, id);
+    }
+}
+
+void Mesh::reset_simplex_attributes(PrimitiveType type, const std::vector<int64_t>& ids)
+{
+    auto run = [&](auto t) {
+        using T = decltype(t);
+        attribute::MeshAttributes<T>& attributes = m_attribute_manager.get<T>(type);
+        for (const auto& [name, handle] : attributes.m_handles) {
+            TypedAttributeHandle<T> typed_handle;
+            typed_handle.m_base_handle = handle;
+            typed_handle.m_primitive_type = type;
+            if constexpr (std::is_same_v<T, char>) {
+                if (typed_handle == m_flag_handles[get_primitive_type_id(type)]) continue;
+            }
+            if constexpr (std::is_same_v<T, int64_t>) {
+                if (typed_handle == m_cell_hash_handle) continue;
+            }
+
+            // written straight into the storage, bypassing the scopes. The free list only hands
+            // out ids deleted before the outermost scope, and takes them back on a rollback, so
+            // no scope can bring back what the slots held before
+            attribute::Attribute<T>& attr = attributes.attribute(handle);
+            const T default_value = attr.default_value();
+            for (const int64_t id : ids) {
+                attr.vector_attribute(id).setConstant(default_value);
+            }
+        }
+    };
+    run(char{});
+    run(int64_t{});
+    run(double{});
+    run(Rational{});
+}
+
 int64_t Mesh::capacity(PrimitiveType type) const
 {
     return m_attribute_manager.m_capacities.at(get_primitive_type_id(type));
 }
 
+std::vector<attribute::StorageStats> Mesh::storage_stats() const
+{
+    std::vector<attribute::StorageStats> stats(top_cell_dimension() + 1);
+    for (int64_t dim = 0; dim < int64_t(stats.size()); ++dim) {
+        const PrimitiveType type = get_primitive_type_from_id(dim);
+        attribute::StorageStats& s = stats[dim];
+        s.capacity = capacity(type);
+        s.reserved = m_attribute_manager.reserved_size(dim);
+        s.peak_reserved = m_attribute_manager.m_peak_reserved[dim];
+
+        const attribute::Accessor<char> flag_accessor = get_const_flag_accessor(type);
+        const attribute::CachingAccessor<char>& flags = flag_accessor.index_access();
+        for (int64_t j = 0; j < s.capacity; ++j) {
+            if ((flags.const_scalar_attribute(j) & 0x1) != 0) {
+                ++s.live;
+            }
+        }
+    }
+    return stats;
+}
+
 void Mesh::reserve_attributes_to_fit()
 {
     m_attribute_manager.reserve_to_fit();
@@ -118,7 +215,16 @@ void Mesh::guarantee_at_least_attributes(const std::vector<int64_t>& sizes)
 }
 void Mesh::guarantee_more_attributes(PrimitiveType type, int64_t size)
 {
-    m_attribute_manager.guarantee_more_attributes(get_primitive_type_id(type), size);
+    std::lock_guard<std::mutex> lock(*m_attribute_manager.m_allocation_mutex);
+    const int64_t primitive_id = get_primitive_type_id(type);
+    if (m_accessed_concurrently &&
+        capacity(type) + size > m_attribute_manager.reserved_size(primitive_id)) {
+        log_and_throw_error(
+            "Cannot grow the {} storage beyond {} while the mesh is accessed concurrently",
+            primitive_type_name(type),
+            m_attribute_manager.reserved_size(primitive_id));
+    }
+    m_attribute_manager.guarantee_more_attributes(primitive_id, size);
 }
 void Mesh::guarantee_more_attributes(const std::vector<int64_t>& sizes)
 {
@@ -187,7 +293,8 @@ attribute::AttributeScopeHandle Mesh::create_single_mesh_scope()
     return m_attribute_manager.create_scope(*this);
 }
 
-std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>> Mesh::consolidate()
+std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>>
+Mesh::consolidation_maps() const
 {
     // Number of dimensions
     int64_t tcp = top_cell_dimension() + 1;
@@ -199,9 +306,12 @@ std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>>
 
     // Initialize both maps
     for (int64_t d = 0; d < tcp; d++) {
-        attribute::Accessor<char> flag_accessor = get_flag_accessor(wmtk::get_primitive_type_from_id(d));
-        for (int64_t i = 0; i < capacity(wmtk::get_primitive_type_from_id(d)); ++i) {
-            if (flag_accessor.index_access().scalar_attribute(i) & 1) {
+        const attribute::Accessor<char> flag_accessor =
+            get_const_flag_accessor(wmtk::get_primitive_type_from_id(d));
+        const int64_t cap = capacity(wmtk::get_primitive_type_from_id(d));
+        old2new[d].reserve(cap);
+        for (int64_t i = 0; i < cap; ++i) {
+            if (flag_accessor.index_access().const_scalar_attribute(i) & 1) {
                 old2new[d].push_back(new2old[d].size());
                 new2old[d].push_back(old2new[d].size() - 1); // -1 since we just pushed into it
             } else {
@@ -209,6 +319,19 @@ std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>>
             }
         }
     }
+    return {std::move(new2old), std::move(old2new)};
+}
+
+std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>> Mesh::consolidate()
+{
+    // Number of dimensions
+    int64_t tcp = top_cell_dimension() + 1;
+
+    // Store the map from new indices to old and from old indices to new. First index is
+    // dimensions, second simplex id
+    std::vector<std::vector<int64_t>> new2old;
+    std::vector<std::vector<int64_t>> old2new;
+    std::tie(new2old, old2new) = consolidation_maps();
 
     // Use new2oldmap to compact all attributes
     auto run = [&](auto&& mesh_attrs) {
@@ -226,10 +349,11 @@ std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>>
 
     run(m_attribute_manager.m_rational_attributes);
 
-    // Update the attribute size in the manager
+    // Update the attribute size in the manager, there are no deleted simplices left to reuse
     for (int64_t d = 0; d < tcp; d++) {
         m_attribute_manager.m_capacities[d] = new2old[d].size();
     }
+    m_attribute_manager.m_free_ids.clear();
 
     // Apply old2new to attributes containing indices
     std::vector<std::vector<TypedAttributeHandle<int64_t>>> handle_indices =
@@ -285,8 +409,205 @@ std::tuple<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>>
     }
 
     // Return both maps for custom attribute remapping
-    return {new2old, old2new};
+    return {std::move(new2old), std::move(old2new)};
+}
+namespace {
+// replaces old_id by new_id in an entry of an attribute holding indices, in every column if
+// column < 0
+struct IndexPatch
+{
+    attribute::Attribute<int64_t>* attribute;
+    int64_t index;
+    int64_t column;
+    int64_t old_id;
+    int64_t new_id;
+};
+
+void apply_patch(const IndexPatch& patch)
+{
+    auto vec = patch.attribute->vector_attribute(patch.index);
+    if (patch.column >= 0) {
+        if (vec(patch.column) == patch.old_id) vec(patch.column) = patch.new_id;
+        return;
+    }
+    for (int64_t j = 0; j < vec.size(); ++j) {
+        if (vec(j) == patch.old_id) vec(j) = patch.new_id;
+    }
 }
+} // namespace
+
+std::vector<std::vector<std::array<int64_t, 2>>> Mesh::consolidate_incremental()
+{
+    // Number of dimensions
+    const int64_t tcp = top_cell_dimension() + 1;
+    const int64_t top_dim = tcp - 1;
+    const PrimitiveType top_type = top_simplex_type();
+
+    // The valid simplices at the end are moved to the released ids, from the smallest on, until
+    // there is no valid simplex left past a released id
+    std::vector<std::vector<std::array<int64_t, 2>>> moves(tcp);
+    std::vector<int64_t> old_capacities(tcp);
+    std::vector<int64_t> new_capacities(tcp);
+    for (int64_t d = 0; d < tcp; ++d) {
+        const PrimitiveType type = get_primitive_type_from_id(d);
+        const attribute::Accessor<char> flag_accessor = get_const_flag_accessor(type);
+        const attribute::CachingAccessor<char>& flags = flag_accessor.index_access();
+        auto is_valid_id = [&](int64_t i) { return (flags.const_scalar_attribute(i) & 1) != 0; };
+
+        std::vector<int64_t> holes = m_attribute_manager.m_free_ids.ids(d);
+        std::sort(holes.begin(), holes.end());
+
+        old_capacities[d] = capacity(type);
+        int64_t end = old_capacities[d];
+        size_t next = 0;
+        while (true) {
+            // the holes filled so far hold valid simplices again
+            const int64_t filled_end = next == 0 ? 0 : holes[next - 1] + 1;
+            while (end > filled_end && !is_valid_id(end - 1)) {
+                --end;
+            }
+            if (next == holes.size() || holes[next] >= end) {
+                break;
+            }
+            assert(!is_valid_id(holes[next]));
+            assert(next == 0 || holes[next - 1] < holes[next]);
+            moves[d].push_back({{end - 1, holes[next]}});
+            ++next;
+            --end;
+        }
+        new_capacities[d] = end;
+    }
+
+    // Find the references to the moved simplices before anything is changed, they are patched
+    // where they are now and moved afterwards with the rest of the data
+    const std::vector<std::vector<TypedAttributeHandle<int64_t>>> handle_indices =
+        connectivity_attributes();
+    // the attribute storing the faces of dimension d of the top simplices
+    auto top_simplex_faces = [&](int64_t d) -> attribute::Attribute<int64_t>& {
+        const auto it = std::find_if(
+            handle_indices[d].begin(),
+            handle_indices[d].end(),
+            [&](const TypedAttributeHandle<int64_t>& h) { return h.primitive_type() == top_type; });
+        assert(it != handle_indices[d].end());
+        return create_accessor<int64_t>(*it).attribute();
+    };
+
+    std::vector<IndexPatch> patches;
+    for (int64_t d = 0; d < tcp; ++d) {
+        const PrimitiveType type = get_primitive_type_from_id(d);
+        for (const auto& [old_id, new_id] : moves[d]) {
+            // the top simplices containing a simplex refer to it
+            std::vector<int64_t> cofaces;
+            if (d < top_dim) {
+                const simplex::Simplex s(type, tuple_from_id(type, old_id));
+                for (const Tuple& t : simplex::top_dimension_cofaces_tuples(*this, s)) {
+                    cofaces.push_back(id(t, top_type));
+                }
+            }
+
+            for (const TypedAttributeHandle<int64_t>& handle : handle_indices[d]) {
+                attribute::Attribute<int64_t>& attr = create_accessor<int64_t>(handle).attribute();
+                const int64_t attr_dim = get_primitive_type_id(handle.primitive_type());
+
+                std::vector<int64_t> indices;
+                if (attr_dim == top_dim && d < top_dim) {
+                    indices = cofaces;
+                } else {
+                    // a top simplex is referred to by its neighbors and by its faces
+                    const attribute::Attribute<int64_t>& adjacency =
+                        attr_dim == top_dim ? attr : top_simplex_faces(attr_dim);
+                    const auto row = adjacency.const_vector_attribute(old_id);
+                    for (int64_t j = 0; j < row.size(); ++j) {
+                        if (row(j) >= 0) indices.push_back(row(j));
+                    }
+                }
+                for (const int64_t index : indices) {
+                    patches.push_back(IndexPatch{&attr, index, -1, old_id, new_id});
+                }
+            }
+        }
+    }
+
+    // The multimesh maps store the ids of the top simplices in their tuples, see consolidate
+    {
+        constexpr static int64_t TUPLE_SIZE = multimesh::utils::TUPLE_SIZE; // in terms of int64_t
+        constexpr static int64_t GLOBAL_ID_INDEX = multimesh::utils::GLOBAL_ID_INDEX;
+        constexpr static int64_t IMAGE_GLOBAL_ID_INDEX = TUPLE_SIZE + GLOBAL_ID_INDEX;
+        for (const auto& [old_id, new_id] : moves[top_dim]) {
+            if (auto parent_ptr = m_multi_mesh_manager.m_parent; parent_ptr != nullptr) {
+                auto acc = create_accessor(m_multi_mesh_manager.map_to_parent_handle);
+                auto& attr = acc.attribute();
+                patches.push_back(IndexPatch{&attr, old_id, GLOBAL_ID_INDEX, old_id, new_id});
+
+                const Tuple parent_tuple = multimesh::utils::vector_to_tuple(
+                    attr.const_vector_attribute(old_id).tail<TUPLE_SIZE>());
+                if (!parent_tuple.is_null()) {
+                    const int64_t child_id = m_multi_mesh_manager.m_child_id;
+                    const auto& child_data = parent_ptr->m_multi_mesh_manager.m_children[child_id];
+                    auto parent_acc = parent_ptr->create_accessor(child_data.map_handle);
+                    patches.push_back(IndexPatch{
+                        &parent_acc.attribute(),
+                        parent_ptr->id(parent_tuple, top_type),
+                        IMAGE_GLOBAL_ID_INDEX,
+                        old_id,
+                        new_id});
+                }
+            }
+
+            for (const auto& child_data : m_multi_mesh_manager.m_children) {
+                Mesh& child = *child_data.mesh;
+                auto acc = create_accessor(child_data.map_handle);
+                auto& attr = acc.attribute();
+                auto child_acc = child.create_accessor(child.m_multi_mesh_manager.map_to_parent_handle);
+                auto& child_attr = child_acc.attribute();
+
+                // the map is stored on the simplices of the top dimension of the child
+                const int64_t child_dim = child.top_cell_dimension();
+                std::vector<int64_t> faces;
+                if (child_dim == top_dim) {
+                    faces.push_back(old_id);
+                } else {
+                    const auto row = top_simplex_faces(child_dim).const_vector_attribute(old_id);
+                    faces.assign(row.begin(), row.end());
+                }
+                for (const int64_t face : faces) {
+                    patches.push_back(IndexPatch{&attr, face, GLOBAL_ID_INDEX, old_id, new_id});
+                    const int64_t child_cell = attr.const_vector_attribute(face)(IMAGE_GLOBAL_ID_INDEX);
+                    if (child_cell >= 0) {
+                        patches.push_back(
+                            IndexPatch{&child_attr, child_cell, IMAGE_GLOBAL_ID_INDEX, old_id, new_id});
+                    }
+                }
+            }
+        }
+    }
+
+    // the old and the new ids are disjoint, so the order of the patches does not matter
+    for (const IndexPatch& patch : patches) {
+        apply_patch(patch);
+    }
+
+    // Move the data of all attributes and reset the slots past the new capacities
+    auto run = [&](auto&& mesh_attrs) {
+        for (int64_t d = 0; d < mesh_attrs.size(); ++d) {
+            for (auto& h : mesh_attrs[d].m_attributes) {
+                h->consolidate(moves[d], new_capacities[d], old_capacities[d]);
+            }
+        }
+    };
+    run(m_attribute_manager.m_char_attributes);
+    run(m_attribute_manager.m_long_attributes);
+    run(m_attribute_manager.m_double_attributes);
+    run(m_attribute_manager.m_rational_attributes);
+
+    for (int64_t d = 0; d < tcp; d++) {
+        m_attribute_manager.m_capacities[d] = new_capacities[d];
+    }
+    m_attribute_manager.m_free_ids.clear();
+
+    return moves;
+}
+
 std::vector<attribute::MeshAttributeHandle::HandleVariant> Mesh::builtin_attributes() const
 {
     std::vector<attribute::MeshAttributeHandle::HandleVariant> data;
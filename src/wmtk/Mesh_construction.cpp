@@ -16,6 +16,8 @@ Mesh::Mesh(Mesh&& other)
 {
     m_flag_handles = std::move(other.m_flag_handles);
     m_cell_hash_handle = std::move(other.m_cell_hash_handle);
+    m_cell_hash_accessor =
+        std::make_unique<attribute::Accessor<int64_t>>(*this, m_cell_hash_handle);
 }
 
 
@@ -26,6 +28,8 @@ Mesh& Mesh::operator=(Mesh&& other)
     m_flag_handles = std::move(other.m_flag_handles);
     m_top_cell_dimension = other.m_top_cell_dimension;
     m_cell_hash_handle = std::move(other.m_cell_hash_handle);
+    m_cell_hash_accessor =
+        std::make_unique<attribute::Accessor<int64_t>>(*this, m_cell_hash_handle);
 
     return *this;
 }
@@ -45,6 +49,8 @@ Mesh::Mesh(const int64_t& dimension, const int64_t& max_primitive_type_id, Primi
         m_flag_handles.emplace_back(
             register_attribute_typed<char>("flags", get_primitive_type_from_id(j), 1, false, 0));
     }
+    m_cell_hash_accessor =
+        std::make_unique<attribute::Accessor<int64_t>>(*this, m_cell_hash_handle);
 }
 
 
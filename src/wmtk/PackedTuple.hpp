@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include "Tuple.hpp"
+
+namespace wmtk {
+
+/**
+ * @brief A Tuple packed into 8 bytes, for large containers of tuples that are only stored and
+ * sorted, like the candidates of a scheduler.
+ *
+ * From the most to the least significant bits: 40 bits for the global cell id + 1, 4 bits each
+ * for the local face, edge and vertex ids + 1, 4 unused bits and 8 bits for the complement of the
+ * hash. A default constructed Tuple packs to 0 and packed tuples sort by their cell first.
+ */
+class PackedTuple
+{
+public:
+    static constexpr int64_t global_cid_bits = 40;
+    /// the largest global cell id that can be packed
+    static constexpr int64_t max_global_cid = (int64_t(1) << global_cid_bits) - 2;
+
+    PackedTuple() = default;
+    explicit PackedTuple(const Tuple& t);
+
+    Tuple unpack() const;
+    uint64_t value() const { return m_value; }
+
+    bool operator==(const PackedTuple& o) const { return m_value == o.m_value; }
+    bool operator!=(const PackedTuple& o) const { return m_value != o.m_value; }
+    bool operator<(const PackedTuple& o) const { return m_value < o.m_value; }
+
+private:
+    static constexpr int cid_shift = 64 - global_cid_bits;
+    static constexpr int fid_shift = 20;
+    static constexpr int eid_shift = 16;
+    static constexpr int vid_shift = 12;
+
+    uint64_t m_value = 0;
+};
+
+inline PackedTuple::PackedTuple(const Tuple& t)
+{
+    assert(t.m_global_cid >= -1 && t.m_global_cid <= max_global_cid);
+    auto local = [](int8_t id, int shift) { return uint64_t(id + 1) << shift; };
+    m_value = (uint64_t(t.m_global_cid + 1) << cid_shift) | local(t.m_local_fid, fid_shift) |
+              local(t.m_local_eid, eid_shift) | local(t.m_local_vid, vid_shift) |
+              uint64_t(uint8_t(~t.m_hash));
+}
+
+inline Tuple PackedTuple::unpack() const
+{
+    auto local = [this](int shift) { return int8_t(int64_t((m_value >> shift) & 0xF) - 1); };
+    return Tuple(
+        local(vid_shift),
+        local(eid_shift),
+        local(fid_shift),
+        int64_t(m_value >> cid_shift) - 1,
+        int8_t(~uint8_t(m_value & 0xFF)));
+}
+
+inline std::vector<PackedTuple> pack_tuples(const std::vector<Tuple>& tuples)
+{
+    std::vector<PackedTuple> ret;
+    ret.reserve(tuples.size());
+    for (const Tuple& t : tuples) {
+        ret.emplace_back(t);
+    }
+    return ret;
+}
+
+inline std::vector<Tuple> unpack_tuples(const std::vector<PackedTuple>& tuples)
+{
+    std::vector<Tuple> ret;
+    ret.reserve(tuples.size());
+    for (const PackedTuple& t : tuples) {
+        ret.emplace_back(t.unpack());
+    }
+    return ret;
+}
+
+} // namespace wmtk
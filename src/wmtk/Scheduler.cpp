@@ -2,33 +2,83 @@
 
 #include "Mesh.hpp"
 
-#include <wmtk/simplex/utils/tuple_vector_to_homogeneous_simplex_vector.hpp>
+#include <wmtk/simplex/closed_star.hpp>
+#include <wmtk/simplex/faces_single_dimension.hpp>
+#include <wmtk/simplex/top_dimension_cofaces.hpp>
 #include <wmtk/utils/Logger.hpp>
 #include <wmtk/utils/random_seed.hpp>
 
 #include <polysolve/Utils.hpp>
 
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 #include <algorithm>
+#include <chrono>
+#include <optional>
+#include <queue>
 #include <random>
+#include <unordered_map>
 
 namespace wmtk {
 
+namespace {
+// the storage use after a run, to size the reservation of the following ones
+void log_storage_stats(const Mesh& mesh)
+{
+    if (!logger().should_log(spdlog::level::debug)) {
+        return;
+    }
+    const std::vector<attribute::StorageStats> stats = mesh.storage_stats();
+    for (int64_t d = 0; d < int64_t(stats.size()); ++d) {
+        logger().debug(
+            "{}: {} live, {} allocated, {} reserved, {} peak reserved",
+            primitive_type_name(get_primitive_type_from_id(d)),
+            stats[d].live,
+            stats[d].capacity,
+            stats[d].reserved,
+            stats[d].peak_reserved);
+    }
+}
+
+struct Candidate
+{
+    PackedTuple tuple;
+    int64_t attempts = 0;
+};
+} // namespace
+
 Scheduler::Scheduler() = default;
 Scheduler::~Scheduler() = default;
 
+void Scheduler::set_number_of_threads(int64_t num_threads)
+{
+    if (num_threads < 1) {
+        log_and_throw_error("Scheduler needs at least one thread, got {}", num_threads);
+    }
+    m_num_threads = num_threads;
+}
+
+void Scheduler::set_max_attempts(int64_t max_attempts)
+{
+    if (max_attempts < 1) {
+        log_and_throw_error("Scheduler needs at least one attempt, got {}", max_attempts);
+    }
+    m_max_attempts = max_attempts;
+}
+
 SchedulerStats Scheduler::run_operation_on_all(operations::Operation& op)
 {
     SchedulerStats res;
-    std::vector<simplex::Simplex> simplices;
-    op.reserve_enough_simplices();
+    // all candidates have the type of the operation, keep the packed tuples only
+    std::vector<PackedTuple> simplices;
 
     const auto type = op.primitive_type();
     {
         POLYSOLVE_SCOPED_STOPWATCH("Collecting primitives", res.collecting_time, logger());
 
-        const auto tups = op.mesh().get_all(type);
-        simplices = wmtk::simplex::utils::tuple_vector_to_homogeneous_simplex_vector(tups, type);
+        simplices = op.mesh().get_all_packed(type);
     }
 
 
@@ -41,23 +91,31 @@ SchedulerStats Scheduler::run_operation_on_all(operations::Operation& op)
 
             std::shuffle(simplices.begin(), simplices.end(), gen);
         } else {
-            std::stable_sort(
-                simplices.begin(),
-                simplices.end(),
-                [&op](const auto& s_a, const auto& s_b) {
-                    return op.priority(s_a) < op.priority(s_b);
-                });
+            // evaluate every priority once and sort the keys next to their simplex
+            std::vector<std::pair<operations::PriorityKey, int64_t>> keys;
+            keys.reserve(simplices.size());
+            for (int64_t j = 0; j < int64_t(simplices.size()); ++j) {
+                keys.emplace_back(op.priority(simplex::Simplex(type, simplices[j].unpack())), j);
+            }
+            std::stable_sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) {
+                return a.first < b.first;
+            });
+
+            std::vector<PackedTuple> sorted;
+            sorted.reserve(simplices.size());
+            for (const auto& [key, j] : keys) {
+                sorted.emplace_back(simplices[j]);
+            }
+            simplices = std::move(sorted);
         }
     }
 
     {
         POLYSOLVE_SCOPED_STOPWATCH("Executing operation", res.executing_time, logger());
-        for (const simplex::Simplex& s : simplices) {
-            auto mods = op(s);
-            if (mods.empty())
-                res.fail();
-            else
-                res.succeed();
+        if (m_num_threads > 1) {
+            run_parallel(op, simplices, res);
+        } else {
+            run_serial(op, simplices, res);
         }
     }
 
@@ -72,10 +130,313 @@ SchedulerStats Scheduler::run_operation_on_all(operations::Operation& op)
         res.number_of_performed_operations(),
         res.number_of_successful_operations(),
         res.number_of_failed_operations());
+    log_storage_stats(op.mesh());
 
     m_stats += res;
 
     return res;
 }
 
+namespace {
+struct QueueEntry
+{
+    operations::PriorityKey key;
+    int64_t stamp;
+    PackedTuple tuple;
+
+    // std::priority_queue pops the largest element first, invert the order so that the smallest
+    // key (and the oldest entry among equal keys) comes out first
+    bool operator<(const QueueEntry& o) const
+    {
+        if (o.key < key) return true;
+        if (key < o.key) return false;
+        return stamp > o.stamp;
+    }
+};
+} // namespace
+
+SchedulerStats Scheduler::run_operation_until_convergence(
+    operations::Operation& op,
+    int64_t max_successful_operations)
+{
+    if (op.use_random_priority()) {
+        return run_operation_on_all(op);
+    }
+
+    SchedulerStats res;
+
+    Mesh& mesh = op.mesh();
+    const auto type = op.primitive_type();
+
+    std::priority_queue<QueueEntry> queue;
+    // the most recent stamp pushed for each simplex id, older entries are stale
+    std::unordered_map<int64_t, int64_t> latest_stamp;
+    int64_t stamp = 0;
+
+    auto push = [&](const simplex::Simplex& s) {
+        latest_stamp[mesh.id(s.tuple(), type)] = stamp;
+        queue.push(QueueEntry{op.priority(s), stamp++, PackedTuple(s.tuple())});
+    };
+
+    {
+        POLYSOLVE_SCOPED_STOPWATCH("Collecting primitives", res.collecting_time, logger());
+        for (const Tuple& t : mesh.get_all(type)) {
+            push(simplex::Simplex(type, t));
+        }
+    }
+
+    logger().info("Executing on {} simplices until convergence", queue.size());
+
+    {
+        POLYSOLVE_SCOPED_STOPWATCH("Executing operation", res.executing_time, logger());
+        while (!queue.empty() &&
+               res.number_of_successful_operations() < max_successful_operations) {
+            QueueEntry entry = queue.top();
+            queue.pop();
+
+            const simplex::Simplex s(type, entry.tuple.unpack());
+            const Tuple& t = s.tuple();
+            if (!mesh.is_valid_current(t)) {
+                continue;
+            }
+            const auto it = latest_stamp.find(mesh.id(t, type));
+            if (it == latest_stamp.end() || it->second != entry.stamp) {
+                continue;
+            }
+            if (operations::PriorityKey key = op.priority(s); key != entry.key) {
+                push(s);
+                continue;
+            }
+            latest_stamp.erase(it);
+
+            const std::vector<simplex::Simplex> mods = op(s);
+            if (mods.empty()) {
+                res.fail();
+                continue;
+            }
+            res.succeed();
+
+            simplex::SimplexCollection neighbors(mesh);
+            for (const simplex::Simplex& m : mods) {
+                neighbors.add(simplex::closed_star(mesh, m, false));
+            }
+            neighbors.sort_and_clean();
+            const std::vector<simplex::Simplex> requeued = neighbors.simplex_vector(type);
+            for (const simplex::Simplex& n : requeued) {
+                push(n);
+            }
+            res.requeue(requeued.size());
+        }
+    }
+
+    logger().info(
+        "Ran {} ops, {} succeeded, {} failed, {} simplices requeued",
+        res.number_of_performed_operations(),
+        res.number_of_successful_operations(),
+        res.number_of_failed_operations(),
+        res.number_of_requeued_simplices());
+    log_storage_stats(mesh);
+
+    m_stats += res;
+
+    return res;
+}
+
+void Scheduler::run_serial(
+    operations::Operation& op,
+    const std::vector<PackedTuple>& simplices,
+    SchedulerStats& res)
+{
+    const PrimitiveType type = op.primitive_type();
+    for (const PackedTuple& t : simplices) {
+        auto mods = op(simplex::Simplex(type, t.unpack()));
+        if (mods.empty())
+            res.fail();
+        else
+            res.succeed();
+    }
+}
+
+int64_t Scheduler::neighborhood_vertices(
+    const Mesh& mesh,
+    const simplex::Simplex& s,
+    std::vector<int64_t>& vertices)
+{
+    const Mesh& root = mesh.get_multi_mesh_root();
+    const simplex::Simplex root_simplex = mesh.is_multi_mesh_root() ? s : mesh.map_to_root(s);
+    const PrimitiveType top_type = root.top_simplex_type();
+
+    vertices.clear();
+    if (top_type == PrimitiveType::Vertex) {
+        vertices.emplace_back(root.id(root_simplex.tuple(), PrimitiveType::Vertex));
+        return 1;
+    }
+
+    std::vector<Tuple> simplex_vertices;
+    if (root_simplex.primitive_type() == PrimitiveType::Vertex) {
+        simplex_vertices.emplace_back(root_simplex.tuple());
+    } else {
+        simplex_vertices =
+            simplex::faces_single_dimension_tuples(root, root_simplex, PrimitiveType::Vertex);
+    }
+
+    int64_t cell_count = 0;
+    simplex::TopDimensionCofacesBuffer cells;
+    for (const Tuple& v : simplex_vertices) {
+        cells.clear();
+        simplex::top_dimension_cofaces_tuples(root, simplex::Simplex::vertex(v), cells);
+        cell_count += cells.size();
+        for (const Tuple& c : cells) {
+            for (const Tuple& cv : simplex::faces_single_dimension_tuples(
+                     root,
+                     simplex::Simplex(top_type, c),
+                     PrimitiveType::Vertex)) {
+                vertices.emplace_back(root.id(cv, PrimitiveType::Vertex));
+            }
+        }
+    }
+    return cell_count;
+}
+
+void Scheduler::reserve_for_round(Mesh& mesh, int64_t cell_count)
+{
+    // an operation replaces at most the cells around its vertices, be generous and allow each
+    // of them to produce two new cells with all their faces. Growing on demand reallocates the
+    // attributes other threads are reading, so this is the safe point to grow.
+    auto run = [&](Mesh& m) {
+        const int64_t faces_per_cell = m.top_cell_dimension() + 1;
+        for (int64_t d = 0; d <= m.top_cell_dimension(); ++d) {
+            const PrimitiveType pt = get_primitive_type_from_id(d);
+            m.guarantee_at_least_attributes(pt, m.capacity(pt) + 2 * faces_per_cell * cell_count);
+        }
+    };
+    Mesh& root = mesh.get_multi_mesh_root();
+    run(root);
+    for (const std::shared_ptr<Mesh>& child : root.get_all_child_meshes()) {
+        run(*child);
+    }
+}
+
+void Scheduler::set_accessed_concurrently(Mesh& mesh, bool value)
+{
+    Mesh& root = mesh.get_multi_mesh_root();
+    root.set_accessed_concurrently(value);
+    for (const std::shared_ptr<Mesh>& child : root.get_all_child_meshes()) {
+        child->set_accessed_concurrently(value);
+    }
+}
+
+void Scheduler::run_parallel(
+    operations::Operation& op,
+    const std::vector<PackedTuple>& simplices,
+    SchedulerStats& res)
+{
+    Mesh& mesh = op.mesh();
+    const Mesh& root = mesh.get_multi_mesh_root();
+    const PrimitiveType type = op.primitive_type();
+
+    std::vector<Candidate> pending;
+    pending.reserve(simplices.size());
+    for (const PackedTuple& t : simplices) {
+        pending.push_back(Candidate{t, 0});
+    }
+
+    // the arena limits the concurrency of this run, the process wide limit is only raised to
+    // honor more threads than the hardware concurrency, never lowered for other tbb users
+    std::optional<tbb::global_control> parallelism;
+    if (m_num_threads > tbb::this_task_arena::max_concurrency()) {
+        parallelism.emplace(tbb::global_control::max_allowed_parallelism, m_num_threads);
+    }
+    tbb::task_arena arena(m_num_threads);
+    const size_t n_slots = arena.max_concurrency();
+    res.per_thread_executing_time.resize(n_slots, 0);
+
+    // vertex v belongs to the batch of the current round iff marks[v] == round_id
+    std::vector<int64_t> marks;
+    std::vector<int64_t> neighborhood;
+    std::vector<Candidate> batch;
+    std::vector<Candidate> deferred;
+    std::vector<char> succeeded;
+
+    int64_t round_id = 0;
+    while (!pending.empty()) {
+        ++round_id;
+        res.round();
+
+        marks.resize(root.capacity(PrimitiveType::Vertex), 0);
+        batch.clear();
+        deferred.clear();
+
+        int64_t cell_count = 0;
+        for (Candidate& c : pending) {
+            // candidates invalidated by the previous rounds cost a single load
+            const Tuple t = c.tuple.unpack();
+            if (!mesh.is_valid_current(t)) {
+                res.fail();
+                continue;
+            }
+
+            const int64_t n_cells =
+                neighborhood_vertices(mesh, simplex::Simplex(type, t), neighborhood);
+            const bool conflicts = std::any_of(
+                neighborhood.begin(),
+                neighborhood.end(),
+                [&](int64_t v) { return marks[v] == round_id; });
+            if (conflicts) {
+                res.conflict();
+                deferred.emplace_back(std::move(c));
+                continue;
+            }
+            for (const int64_t v : neighborhood) {
+                marks[v] = round_id;
+            }
+            // only the batch runs this round, the deferred candidates reserve in a later one
+            cell_count += n_cells;
+            batch.emplace_back(std::move(c));
+        }
+
+        // operations must never resize attributes while other threads access them
+        reserve_for_round(mesh, cell_count);
+
+        succeeded.assign(batch.size(), 0);
+        set_accessed_concurrently(mesh, true);
+        try {
+            arena.execute([&] {
+                tbb::parallel_for(size_t(0), batch.size(), [&](size_t j) {
+                    const int slot = tbb::this_task_arena::current_thread_index();
+                    const auto start = std::chrono::steady_clock::now();
+                    succeeded[j] = !op(simplex::Simplex(type, batch[j].tuple.unpack())).empty();
+                    const auto end = std::chrono::steady_clock::now();
+                    res.per_thread_executing_time[slot] +=
+                        std::chrono::duration<double>(end - start).count();
+                });
+            });
+        } catch (...) {
+            // e.g. an operation needed more storage than reserved for the round
+            set_accessed_concurrently(mesh, false);
+            throw;
+        }
+        set_accessed_concurrently(mesh, false);
+
+        // deferred candidates keep their priority order, retries go after them
+        pending.swap(deferred);
+        for (size_t j = 0; j < batch.size(); ++j) {
+            if (succeeded[j]) {
+                res.succeed();
+            } else if (++batch[j].attempts < m_max_attempts) {
+                res.retry();
+                pending.emplace_back(std::move(batch[j]));
+            } else {
+                res.fail();
+            }
+        }
+    }
+
+    logger().debug(
+        "Parallel execution took {} rounds, {} conflicts, {} retries",
+        res.number_of_rounds(),
+        res.number_of_conflicts(),
+        res.number_of_retries());
+}
+
 } // namespace wmtk
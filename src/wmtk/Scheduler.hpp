@@ -1,7 +1,11 @@
 #pragma once
 
+#include "PackedTuple.hpp"
 #include "operations/Operation.hpp"
 
+#include <limits>
+#include <vector>
+
 namespace wmtk {
 
 class SchedulerStats
@@ -28,27 +32,76 @@ public:
      */
     int64_t number_of_performed_operations() const { return m_num_op_success + m_num_op_fail; }
 
+    /**
+     * @brief Returns the number of times a candidate was deferred because its neighborhood
+     * overlapped with a candidate already scheduled in the same parallel round.
+     *
+     * Always 0 when running serially.
+     */
+    int64_t number_of_conflicts() const { return m_num_conflicts; }
+
+    /**
+     * @brief Returns the number of times a failed candidate was queued again for a later round.
+     *
+     * Always 0 when running serially.
+     */
+    int64_t number_of_retries() const { return m_num_retries; }
+
+    /**
+     * @brief Returns the number of independent-set rounds used by the parallel execution.
+     *
+     * Always 0 when running serially.
+     */
+    int64_t number_of_rounds() const { return m_num_rounds; }
+
+    /**
+     * @brief Returns the number of simplices pushed back into the queue after a successful
+     * operation in `run_operation_until_convergence`.
+     */
+    int64_t number_of_requeued_simplices() const { return m_num_requeued; }
+
     inline void succeed() { ++m_num_op_success; }
     inline void fail() { ++m_num_op_fail; }
+    inline void conflict() { ++m_num_conflicts; }
+    inline void retry() { ++m_num_retries; }
+    inline void round() { ++m_num_rounds; }
+    inline void requeue(int64_t count = 1) { m_num_requeued += count; }
 
     inline void operator+=(const SchedulerStats& s)
     {
         m_num_op_success += s.m_num_op_success;
         m_num_op_fail += s.m_num_op_fail;
+        m_num_conflicts += s.m_num_conflicts;
+        m_num_retries += s.m_num_retries;
+        m_num_rounds += s.m_num_rounds;
+        m_num_requeued += s.m_num_requeued;
 
         collecting_time += s.collecting_time;
         sorting_time += s.sorting_time;
         executing_time += s.executing_time;
+
+        if (per_thread_executing_time.size() < s.per_thread_executing_time.size()) {
+            per_thread_executing_time.resize(s.per_thread_executing_time.size(), 0);
+        }
+        for (size_t j = 0; j < s.per_thread_executing_time.size(); ++j) {
+            per_thread_executing_time[j] += s.per_thread_executing_time[j];
+        }
     }
 
 
     double collecting_time = 0;
     double sorting_time = 0;
     double executing_time = 0;
+    /// time (in seconds) each worker thread spent executing operations, indexed by thread slot
+    std::vector<double> per_thread_executing_time;
 
 private:
     int64_t m_num_op_success = 0;
     int64_t m_num_op_fail = 0;
+    int64_t m_num_conflicts = 0;
+    int64_t m_num_retries = 0;
+    int64_t m_num_rounds = 0;
+    int64_t m_num_requeued = 0;
 };
 
 class Scheduler
@@ -57,12 +110,77 @@ public:
     Scheduler();
     ~Scheduler();
 
+    /**
+     * @brief Runs the operation on every simplex of its primitive type.
+     *
+     * With a single thread (the default) simplices are processed one after the other in
+     * priority order. With more threads the candidates are split into rounds of independent
+     * sets: a candidate is scheduled in a round only if the vertices of the top dimension
+     * cofaces around its vertices (measured on the multi-mesh root) are disjoint from the ones
+     * of every candidate already scheduled. Each round is then executed concurrently and
+     * deferred or failed candidates are considered again in the next round.
+     *
+     * The operation (including its invariants, attribute updates and priority) must be safe
+     * to call concurrently on disjoint neighborhoods.
+     */
     SchedulerStats run_operation_on_all(operations::Operation& op);
 
+    /**
+     * @brief Runs the operation from a priority queue until no candidate is left.
+     *
+     * The queue is seeded with every simplex of the operation's primitive type. After each
+     * successful operation, the simplices of that type in the closed star of the modified
+     * simplices are pushed back with a fresh priority, so newly created simplices are handled in
+     * the same run. Entries whose simplex was removed, pushed again later, or whose priority
+     * changed since they were pushed are skipped (the latter is re-inserted with its current
+     * priority).
+     *
+     * Only operations that converge (e.g. splits and collapses guarded by edge length
+     * invariants) should be run this way, max_successful_operations bounds the run otherwise.
+     * Operations with random priorities are run with `run_operation_on_all`.
+     */
+    SchedulerStats run_operation_until_convergence(
+        operations::Operation& op,
+        int64_t max_successful_operations = std::numeric_limits<int64_t>::max());
+
     const SchedulerStats& stats() const { return m_stats; }
 
+    /**
+     * @brief Sets the number of worker threads, 1 runs serially.
+     */
+    void set_number_of_threads(int64_t num_threads);
+    int64_t number_of_threads() const { return m_num_threads; }
+
+    /**
+     * @brief Sets how many times a candidate is tried before being counted as failed in the
+     * parallel mode. The default (1) matches the serial behavior.
+     */
+    void set_max_attempts(int64_t max_attempts);
+    int64_t max_attempts() const { return m_max_attempts; }
+
 private:
+    void run_serial(
+        operations::Operation& op,
+        const std::vector<PackedTuple>& simplices,
+        SchedulerStats& res);
+    void run_parallel(
+        operations::Operation& op,
+        const std::vector<PackedTuple>& simplices,
+        SchedulerStats& res);
+
+    // ids of the root vertices of the top dimension cofaces around the vertices of s, returns
+    // the number of cofaces visited
+    static int64_t neighborhood_vertices(
+        const Mesh& mesh,
+        const simplex::Simplex& s,
+        std::vector<int64_t>& vertices);
+    // makes sure no attribute of the multi-mesh gets resized while a round executes
+    static void reserve_for_round(Mesh& mesh, int64_t cell_count);
+    static void set_accessed_concurrently(Mesh& mesh, bool value);
+
     SchedulerStats m_stats;
+    int64_t m_num_threads = 1;
+    int64_t m_max_attempts = 1;
 };
 
 } // namespace wmtk
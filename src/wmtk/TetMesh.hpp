@@ -10,6 +10,12 @@ class MultiMeshEdgeSplitFunctor;
 class MultiMeshEdgeCollapseFunctor;
 class UpdateEdgeOperationMultiMeshMapFunctor;
 } // namespace operations::utils
+namespace simplex::internal {
+class VertexIdLinkCondition;
+} // namespace simplex::internal
+namespace function {
+class AMIPS;
+} // namespace function
 class TetMesh : public MeshCRTP<TetMesh>
 {
 public:
@@ -17,6 +23,9 @@ public:
     friend class operations::utils::MultiMeshEdgeSplitFunctor;
     friend class operations::utils::MultiMeshEdgeCollapseFunctor;
     friend class operations::utils::UpdateEdgeOperationMultiMeshMapFunctor;
+    friend class simplex::internal::VertexIdLinkCondition;
+    friend class SimplexInversionInvariant;
+    friend class function::AMIPS;
     template <typename U, typename MeshType, int Dim>
     friend class attribute::Accessor;
     TetMesh();
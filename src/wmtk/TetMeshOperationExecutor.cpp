@@ -167,10 +167,18 @@ TetMesh::TetMeshOperationExecutor::TetMeshOperationExecutor(
 
 void TetMesh::TetMeshOperationExecutor::delete_simplices()
 {
+    std::vector<int64_t> deleted_ids;
     for (size_t d = 0; d < simplex_ids_to_delete.size(); ++d) {
+        deleted_ids.clear();
         for (const int64_t id : simplex_ids_to_delete[d]) {
-            flag_accessors[d].index_access().scalar_attribute(id) = 0; // TODO: reset single bit
+            char& flag = flag_accessors[d].index_access().scalar_attribute(id);
+            // ids that are listed twice must only be handed out once
+            if (flag & 0x1) {
+                deleted_ids.emplace_back(id);
+            }
+            flag = 0; // TODO: reset single bit
         }
+        m_mesh.release_simplex_indices(get_primitive_type_from_id(d), deleted_ids);
     }
 }
 
@@ -1045,7 +1053,7 @@ void TetMesh::TetMeshOperationExecutor::collapse_edge()
     delete_simplices();
 
     // debug code
-    assert(m_mesh.is_connectivity_valid());
+    assert(m_mesh.is_accessed_concurrently() || m_mesh.is_connectivity_valid());
     assert(return_tid > -1);
     assert(return_local_fid > -1);
     assert(return_local_eid > -1);
@@ -1062,8 +1070,6 @@ std::vector<int64_t> TetMesh::TetMeshOperationExecutor::request_simplex_indices(
     const PrimitiveType type,
     int64_t count)
 {
-    m_mesh.guarantee_more_attributes(type, count);
-
     return m_mesh.request_simplex_indices(type, count);
 }
 
@@ -149,7 +149,7 @@ Tuple TriMesh::switch_tuple(const Tuple& tuple, PrimitiveType type) const
         assert(lvid_new != -1);
         assert(leid_new != -1);
 
-        const attribute::Accessor<int64_t> hash_accessor = get_const_cell_hash_accessor();
+        const attribute::Accessor<int64_t>& hash_accessor = get_const_cell_hash_accessor();
 
         const Tuple res(
             lvid_new,
@@ -314,7 +314,7 @@ Tuple TriMesh::edge_tuple_from_id(int64_t id) const
             assert(autogen::tri_mesh::auto_2d_table_complete_edge[i][1] == i);
             const int64_t lvid = autogen::tri_mesh::auto_2d_table_complete_edge[i][0];
 
-            const attribute::Accessor<int64_t> hash_accessor = get_const_cell_hash_accessor();
+            const attribute::Accessor<int64_t>& hash_accessor = get_const_cell_hash_accessor();
 
             Tuple e_tuple = Tuple(lvid, i, -1, f, get_cell_hash(f, hash_accessor));
             assert(is_ccw(e_tuple));
@@ -13,6 +13,9 @@ class MultiMeshEdgeSplitFunctor;
 class MultiMeshEdgeCollapseFunctor;
 class UpdateEdgeOperationMultiMeshMapFunctor;
 } // namespace operations::utils
+namespace simplex::internal {
+class VertexIdLinkCondition;
+} // namespace simplex::internal
 
 
 class TriMesh : public MeshCRTP<TriMesh>
@@ -22,6 +25,8 @@ public:
     friend class operations::utils::MultiMeshEdgeCollapseFunctor;
     friend class operations::utils::MultiMeshEdgeSplitFunctor;
     friend class operations::utils::UpdateEdgeOperationMultiMeshMapFunctor;
+    friend class simplex::internal::VertexIdLinkCondition;
+    friend class SimplexInversionInvariant;
     template <typename U, typename MeshType, int Dim>
     friend class attribute::Accessor;
     using MeshCRTP<TriMesh>::create_accessor;
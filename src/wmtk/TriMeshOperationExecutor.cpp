@@ -104,7 +104,7 @@ TriMesh::TriMeshOperationExecutor::TriMeshOperationExecutor(
     , m_mesh(m)
 
 {
-    assert(m.is_connectivity_valid());
+    assert(m.is_accessed_concurrently() || m.is_connectivity_valid());
     m_operating_tuple = operating_tuple;
     // store ids of edge and incident vertices
     m_operating_edge_id = m_mesh.id_edge(m_operating_tuple);
@@ -170,10 +170,18 @@ TriMesh::TriMeshOperationExecutor::TriMeshOperationExecutor(
 
 void TriMesh::TriMeshOperationExecutor::delete_simplices()
 {
+    std::vector<int64_t> deleted_ids;
     for (size_t d = 0; d < simplex_ids_to_delete.size(); ++d) {
+        deleted_ids.clear();
         for (const int64_t id : simplex_ids_to_delete[d]) {
-            flag_accessors[d].index_access().scalar_attribute(id) = 0;
+            char& flag = flag_accessors[d].index_access().scalar_attribute(id);
+            // ids that are listed twice must only be handed out once
+            if (flag & 0x1) {
+                deleted_ids.emplace_back(id);
+            }
+            flag = 0;
         }
+        m_mesh.release_simplex_indices(get_primitive_type_from_id(d), deleted_ids);
     }
 }
 
@@ -561,8 +569,6 @@ std::vector<int64_t> TriMesh::TriMeshOperationExecutor::request_simplex_indices(
     const PrimitiveType type,
     int64_t count)
 {
-    m_mesh.guarantee_more_attributes(type, count);
-
     return m_mesh.request_simplex_indices(type, count);
 }
 
@@ -10,6 +10,7 @@ class PointMesh;
 class TriMesh;
 class EdgeMesh;
 class TetMesh;
+class PackedTuple;
 namespace attribute {
 template <typename T, typename MeshType, int Dim>
 class Accessor;
@@ -49,6 +50,7 @@ public:
     template <typename T, typename MeshType, int Dim>
     friend class attribute::Accessor;
     friend class operations::Operation;
+    friend class PackedTuple;
     friend class utils::TupleCellLessThan;
     friend class utils::TupleInspector;
     // friend int64_t Mesh::id(const Tuple& tuple, const PrimitiveType& type) const;
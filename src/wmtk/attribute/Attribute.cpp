@@ -1,4 +1,5 @@
 #include "Attribute.hpp"
+#include <algorithm>
 #include <numeric>
 #include <wmtk/attribute/PerThreadAttributeScopeStacks.hpp>
 #include <wmtk/io/MeshWriter.hpp>
@@ -16,6 +17,44 @@ void Attribute<T>::serialize(const std::string& name, const int dim, MeshWriter&
     writer.write(name, dim, dimension(), m_data, m_default_value);
 }
 
+template <typename T>
+void Attribute<T>::serialize_consolidated(
+    const std::string& name,
+    const int dim,
+    MeshWriter& writer,
+    const std::vector<int64_t>& new2old,
+    const std::vector<const std::vector<int64_t>*>& column_old2new) const
+{
+    assert(column_old2new.empty() || column_old2new.size() == m_dimension);
+
+    std::vector<T> data;
+    data.reserve(new2old.size() * m_dimension);
+    for (const int64_t old_index : new2old) {
+        const auto begin = m_data.begin() + old_index * m_dimension;
+        data.insert(data.end(), begin, begin + m_dimension);
+    }
+
+    if constexpr (std::is_same_v<T, int64_t>) {
+        for (int64_t j = 0; j < int64_t(column_old2new.size()); ++j) {
+            const std::vector<int64_t>* old2new = column_old2new[j];
+            if (old2new == nullptr) {
+                continue;
+            }
+            for (size_t k = j; k < data.size(); k += m_dimension) {
+                int64_t& v = data[k];
+                if (v >= 0) // Negative number are error codes, not indices
+                    v = (*old2new)[v];
+            }
+        }
+    } else {
+        if (!column_old2new.empty()) {
+            throw std::runtime_error("Only int64_t attributes can be index remapped.");
+        }
+    }
+
+    writer.write(name, dim, dimension(), data, m_default_value);
+}
+
 
 template <typename T>
 Attribute<T>::Attribute(const std::string& name, int64_t dimension, T default_value, int64_t size)
@@ -98,6 +137,17 @@ void Attribute<T>::consolidate(const std::vector<int64_t>& new2old)
 
     m_data.resize(new2old.size() * m_dimension);
 }
+template <typename T>
+void Attribute<T>::consolidate(
+    const std::vector<std::array<int64_t, 2>>& moves,
+    int64_t size,
+    int64_t end)
+{
+    for (const auto& [old_index, new_index] : moves) {
+        vector_attribute(new_index) = vector_attribute(old_index);
+    }
+    std::fill(m_data.begin() + size * m_dimension, m_data.begin() + end * m_dimension, m_default_value);
+}
 
 #if defined(__GNUG__) && !defined(__clang__)
 #pragma GCC diagnostic push
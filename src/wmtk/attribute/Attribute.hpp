@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <array>
 #include <memory>
 #include <vector>
 #include <wmtk/utils/MerkleTreeInteriorNode.hpp>
@@ -45,6 +46,19 @@ public:
     friend class AccessorBase;
     friend class AttributeCache<T>;
     void serialize(const std::string& name, const int dim, MeshWriter& writer) const;
+    /**
+     * @brief Serialize the attribute as if it was consolidated with new2old, without modifying it.
+     *
+     * Only the entries listed in new2old are written, in that order. column_old2new is either
+     * empty or holds one map per column; the indices stored in a column with a non-null map are
+     * remapped like in index_remap.
+     */
+    void serialize_consolidated(
+        const std::string& name,
+        const int dim,
+        MeshWriter& writer,
+        const std::vector<int64_t>& new2old,
+        const std::vector<const std::vector<int64_t>*>& column_old2new) const;
 
     /**
      * @brief Initialize the attribute.
@@ -87,6 +101,10 @@ public:
      * @brief The number of values for each index.
      */
     int64_t dimension() const;
+    /**
+     * @brief The value new entries are initialized with.
+     */
+    const T& default_value() const;
     void reserve(const int64_t size);
 
     bool operator==(const Attribute<T>& o) const;
@@ -97,12 +115,22 @@ public:
 
     const AttributeScopeStack<T>& get_local_scope_stack() const;
     AttributeScopeStack<T>& get_local_scope_stack();
+    /// the scope stack used by every thread while the attribute is not accessed concurrently
+    AttributeScopeStack<T>& get_serial_scope_stack() const;
+
+    void set_accessed_concurrently(bool value);
+    bool is_accessed_concurrently() const;
 
     /**
      * @brief Consolidate the vector, using the new2old map m provided and resizing the vector to
      * m.size()
      */
     void consolidate(const std::vector<int64_t>& new2old);
+    /**
+     * @brief Consolidate only the given entries: every moves[i][0] is copied to moves[i][1], then
+     * the entries in [size, end) are reset to the default value. The storage is kept.
+     */
+    void consolidate(const std::vector<std::array<int64_t, 2>>& moves, int64_t size, int64_t end);
 
     /**
      * @brief Applies the scalar old2new map to the indices in the attribute
@@ -275,6 +303,12 @@ inline int64_t Attribute<T>::dimension() const
     return m_dimension;
 }
 
+template <typename T>
+inline const T& Attribute<T>::default_value() const
+{
+    return m_default_value;
+}
+
 template <typename T>
 inline const AttributeScopeStack<T>& Attribute<T>::get_local_scope_stack() const
 {
@@ -285,6 +319,22 @@ inline AttributeScopeStack<T>& Attribute<T>::get_local_scope_stack()
 {
     return m_scope_stacks.local();
 }
+template <typename T>
+inline AttributeScopeStack<T>& Attribute<T>::get_serial_scope_stack() const
+{
+    return m_scope_stacks.serial();
+}
+
+template <typename T>
+inline void Attribute<T>::set_accessed_concurrently(bool value)
+{
+    m_scope_stacks.set_accessed_concurrently(value);
+}
+template <typename T>
+inline bool Attribute<T>::is_accessed_concurrently() const
+{
+    return m_scope_stacks.is_accessed_concurrently();
+}
 
 template <typename T>
 inline void Attribute<T>::push_scope()
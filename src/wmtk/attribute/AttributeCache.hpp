@@ -5,9 +5,16 @@
 #include "AttributeCacheData.hpp"
 #include "internal/MapTypes.hpp"
 
+#if defined(WMTK_USE_MONOTONIC_ATTRIBUTE_CACHE) && defined(WMTK_USE_FLAT_ATTRIBUTE_CACHE)
+#error "WMTK_USE_MONOTONIC_ATTRIBUTE_CACHE and WMTK_USE_FLAT_ATTRIBUTE_CACHE are exclusive"
+#endif
+
 #if defined(WMTK_USE_MONOTONIC_ATTRIBUTE_CACHE)
 #include <memory_resource>
 #endif
+#if defined(WMTK_USE_FLAT_ATTRIBUTE_CACHE)
+#include "internal/FlatCacheStorage.hpp"
+#endif
 
 
 namespace wmtk::attribute {
@@ -20,6 +27,9 @@ class AttributeCache
 {
 public:
     using Data = AttributeCacheData<T>;
+#if defined(WMTK_USE_FLAT_ATTRIBUTE_CACHE)
+    using DataStorage = internal::FlatCacheStorage<T>;
+#else
     using DataStorage = std::map<
         int64_t,
         Data,
@@ -29,6 +39,7 @@ public:
         std::pmr::polymorphic_allocator<std::pair<const int64_t, Data>>
 #endif
         >;
+#endif
 
     using MapResult = internal::MapResult<T>;
     using ConstMapResult = internal::ConstMapResult<T>;
@@ -46,8 +57,8 @@ public:
     void try_caching(int64_t index, const Eigen::MatrixBase<Derived>& value);
     void try_caching(int64_t index, const T& value);
 
-    typename DataStorage::const_iterator find_value(int64_t index) const;
-    bool is_value(const typename DataStorage::const_iterator& it) const;
+    /// returns the cached value of index, or nullptr if index was not cached
+    const T* find_value(int64_t index) const;
 
     void clear();
     size_t size() const { return m_data.size(); }
@@ -18,15 +18,14 @@ template <typename T>
 inline AttributeCache<T>::~AttributeCache() = default;
 
 template <typename T>
-inline auto AttributeCache<T>::find_value(int64_t index) const ->
-    typename DataStorage::const_iterator
+inline const T* AttributeCache<T>::find_value(int64_t index) const
 {
+#if defined(WMTK_USE_FLAT_ATTRIBUTE_CACHE)
     return m_data.find(index);
-}
-template <typename T>
-inline bool AttributeCache<T>::is_value(const typename DataStorage::const_iterator& it) const
-{
-    return it != m_data.end();
+#else
+    const auto it = m_data.find(index);
+    return it == m_data.end() ? nullptr : it->second.data.data();
+#endif
 }
 
 template <typename T>
@@ -40,24 +39,70 @@ template <typename T>
 template <typename Derived>
 inline void AttributeCache<T>::try_caching(int64_t index, const Eigen::MatrixBase<Derived>& value)
 {
+#if defined(WMTK_USE_FLAT_ATTRIBUTE_CACHE)
+    auto [ptr, did_insert] = m_data.try_emplace(index, value.size());
+    if (did_insert) {
+        for (Eigen::Index j = 0; j < value.size(); ++j) {
+            ptr[j] = value(j);
+        }
+    }
+#else
     // basically try_emplace but optimizes to avoid accessing the pointed-to value
     auto [it, did_insert] = m_data.try_emplace(index, AttributeCacheData<T>{});
     if (did_insert) {
         it->second.data = value;
     }
+#endif
 }
 
 template <typename T>
 inline void AttributeCache<T>::try_caching(int64_t index, const T& value)
 {
+#if defined(WMTK_USE_FLAT_ATTRIBUTE_CACHE)
+    auto [ptr, did_insert] = m_data.try_emplace(index, 1);
+    if (did_insert) {
+        *ptr = value;
+    }
+#else
     // basically try_emplace but optimizes to avoid accessing the pointed-to value
     auto [it, did_insert] = m_data.try_emplace(index, AttributeCacheData<T>{});
     if (did_insert) {
         it->second.data = VectorX<T>::Constant(1, value);
     }
+#endif
 }
 
 
+#if defined(WMTK_USE_FLAT_ATTRIBUTE_CACHE)
+template <typename T>
+inline void AttributeCache<T>::apply_to(Attribute<T>& attribute) const
+{
+    const int64_t dim = m_data.dimension();
+    m_data.for_each([&](int64_t index, const T* data) {
+        attribute.vector_attribute(index) = ConstMapResult(data, dim);
+    });
+}
+template <typename T>
+inline void AttributeCache<T>::apply_to(AttributeCache<T>& other) const
+{
+    const int64_t dim = m_data.dimension();
+    m_data.for_each([&](int64_t index, const T* data) {
+        auto [ptr, did_insert] = other.m_data.try_emplace(index, dim);
+        if (did_insert) {
+            std::copy(data, data + dim, ptr);
+        }
+    });
+}
+
+template <typename T>
+inline void AttributeCache<T>::apply_to(const Attribute<T>& attribute, std::vector<T>& other) const
+{
+    const int64_t dim = m_data.dimension();
+    m_data.for_each([&](int64_t index, const T* data) {
+        attribute.vector_attribute(index, other) = ConstMapResult(data, dim);
+    });
+}
+#else
 template <typename T>
 inline void AttributeCache<T>::apply_to(Attribute<T>& attribute) const
 {
@@ -90,4 +135,5 @@ inline void AttributeCache<T>::apply_to(const Attribute<T>& attribute, std::vect
         attribute.vector_attribute(index, other) = data.data;
     }
 }
+#endif
 } // namespace wmtk::attribute
@@ -1,4 +1,5 @@
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 #include "AttributeManager.hpp"
 #include <wmtk/io/MeshWriter.hpp>
@@ -12,6 +13,9 @@ AttributeManager::AttributeManager(int64_t size)
     , m_double_attributes(size)
     , m_rational_attributes(size)
     , m_capacities(size, 0)
+    , m_free_ids(size)
+    , m_allocation_mutex(std::make_unique<std::mutex>())
+    , m_peak_reserved(size, 0)
 {}
 
 
@@ -64,6 +68,26 @@ void AttributeManager::serialize(MeshWriter& writer) const
     writer.write_capacities(m_capacities);
 }
 
+void AttributeManager::serialize_consolidated(
+    MeshWriter& writer,
+    const std::vector<std::vector<int64_t>>& new2old,
+    const std::vector<std::map<AttributeHandle, std::vector<const std::vector<int64_t>*>>>&
+        index_remaps) const
+{
+    static const std::map<AttributeHandle, std::vector<const std::vector<int64_t>*>> no_remaps;
+
+    std::vector<int64_t> capacities(m_capacities.size());
+    for (int64_t dim = 0; dim < m_capacities.size(); ++dim) {
+        capacities[dim] = new2old[dim].size();
+        if (!writer.write(dim)) continue;
+        m_char_attributes[dim].serialize_consolidated(dim, writer, new2old[dim], no_remaps);
+        m_long_attributes[dim].serialize_consolidated(dim, writer, new2old[dim], index_remaps[dim]);
+        m_double_attributes[dim].serialize_consolidated(dim, writer, new2old[dim], no_remaps);
+        m_rational_attributes[dim].serialize_consolidated(dim, writer, new2old[dim], no_remaps);
+    }
+    writer.write_capacities(capacities);
+}
+
 void AttributeManager::reserve_to_fit()
 {
     for (int64_t dim = 0; dim < m_capacities.size(); ++dim) {
@@ -77,6 +101,7 @@ void AttributeManager::reserve_attributes(int64_t dimension, int64_t capacity)
     m_long_attributes[dimension].reserve(capacity);
     m_double_attributes[dimension].reserve(capacity);
     m_rational_attributes[dimension].reserve(capacity);
+    m_peak_reserved[dimension] = std::max(m_peak_reserved[dimension], capacity);
 }
 
 void AttributeManager::reserve_more_attributes(int64_t dimension, int64_t size)
@@ -96,13 +121,15 @@ void AttributeManager::reserve_more_attributes(const std::vector<int64_t>& more_
 }
 void AttributeManager::guarantee_at_least_attributes(int64_t dimension, int64_t size)
 {
-    assert(dimension < this->size());
-
+    // amortized doubling, every simplex is copied a constant number of times on average
+    constexpr static int64_t growth_factor = 2;
 
-    m_char_attributes[dimension].guarantee_at_least(size);
-    m_long_attributes[dimension].guarantee_at_least(size);
-    m_double_attributes[dimension].guarantee_at_least(size);
-    m_rational_attributes[dimension].guarantee_at_least(size);
+    assert(dimension < this->size());
+    const int64_t reserved = reserved_size(dimension);
+    if (size <= reserved) {
+        return;
+    }
+    reserve_attributes(dimension, std::max(size, growth_factor * reserved));
 }
 
 void AttributeManager::guarantee_at_least_attributes(
@@ -126,10 +153,16 @@ void AttributeManager::guarantee_more_attributes(const std::vector<int64_t>& mor
         guarantee_more_attributes(dim, more_capacities[dim]);
     }
 }
+int64_t AttributeManager::reserved_size(int64_t dimension) const
+{
+    // all types hold the same reservation
+    return m_char_attributes[dimension].reserved_size();
+}
 void AttributeManager::set_capacities(std::vector<int64_t> capacities)
 {
     assert(capacities.size() == m_capacities.size());
     m_capacities = std::move(capacities);
+    m_free_ids.clear();
     reserve_attributes_to_fit();
 }
 void AttributeManager::assert_capacity_valid() const
@@ -204,6 +237,7 @@ void AttributeManager::push_scope()
     for (auto& ma : m_rational_attributes) {
         ma.push_scope();
     }
+    m_free_ids.push_scope();
 }
 void AttributeManager::pop_scope(bool apply_updates)
 {
@@ -219,6 +253,7 @@ void AttributeManager::pop_scope(bool apply_updates)
     for (auto& ma : m_rational_attributes) {
         ma.pop_scope(apply_updates);
     }
+    m_free_ids.pop_scope(apply_updates);
 }
 
 void AttributeManager::rollback_current_scope()
@@ -235,6 +270,23 @@ void AttributeManager::rollback_current_scope()
     for (auto& ma : m_rational_attributes) {
         ma.rollback_current_scope();
     }
+    m_free_ids.rollback_current_scope();
+}
+
+void AttributeManager::set_accessed_concurrently(bool value)
+{
+    for (auto& ma : m_char_attributes) {
+        ma.set_accessed_concurrently(value);
+    }
+    for (auto& ma : m_long_attributes) {
+        ma.set_accessed_concurrently(value);
+    }
+    for (auto& ma : m_double_attributes) {
+        ma.set_accessed_concurrently(value);
+    }
+    for (auto& ma : m_rational_attributes) {
+        ma.set_accessed_concurrently(value);
+    }
 }
 
 void AttributeManager::change_to_parent_scope() const
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <wmtk/attribute/utils/variant_comparison.hpp>
 #include <wmtk/utils/Rational.hpp>
 #include "AttributeScopeHandle.hpp"
 #include "MeshAttributes.hpp"
+#include "SimplexIdFreeList.hpp"
 #include "TypedAttributeHandle.hpp"
 #include "internal/CheckpointScope.hpp"
 
@@ -13,6 +16,21 @@ class Mesh;
 class MeshWriter;
 
 namespace attribute {
+/**
+ * Storage use of the simplices of one dimension, see Mesh::storage_stats.
+ */
+struct StorageStats
+{
+    // simplices that currently exist
+    int64_t live = 0;
+    // ids handed out so far, including the deleted ones
+    int64_t capacity = 0;
+    // simplices the attributes currently have room for
+    int64_t reserved = 0;
+    // the largest reservation since the mesh was created
+    int64_t peak_reserved = 0;
+};
+
 class AttributeManager : public wmtk::utils::MerkleTreeInteriorNode
 {
     friend class internal::CheckpointScope;
@@ -37,6 +55,15 @@ public:
     // max index used for each type of simplex
     std::vector<int64_t> m_capacities;
 
+    // ids of deleted simplices below the capacities that can be reused
+    SimplexIdFreeList m_free_ids;
+
+    // serializes the simplex allocations of operations running concurrently (see Scheduler)
+    std::unique_ptr<std::mutex> m_allocation_mutex;
+
+    // the largest reserved size of each type of simplex
+    std::vector<int64_t> m_peak_reserved;
+
     // the number of types of attributes (types of simplex)
     int64_t size() const;
 
@@ -46,6 +73,16 @@ public:
 
     AttributeScopeHandle create_scope(Mesh& m);
     void serialize(MeshWriter& writer) const;
+    /**
+     * @brief Serialize only the simplices in new2old (indexed by dimension), without modifying
+     * the attributes. index_remaps lists per dimension the int64_t attributes storing indices and
+     * their per-column old2new maps. The written capacities are the sizes of new2old.
+     */
+    void serialize_consolidated(
+        MeshWriter& writer,
+        const std::vector<std::vector<int64_t>>& new2old,
+        const std::vector<std::map<AttributeHandle, std::vector<const std::vector<int64_t>*>>>&
+            index_remaps) const;
     void reserve_to_fit();
     void reserve_attributes_to_fit();
     void reserve_attributes(int64_t dimension, int64_t size);
@@ -55,8 +92,14 @@ public:
     void reserve_more_attributes(const std::vector<int64_t>& more_capacities);
     void guarantee_more_attributes(int64_t dimension, int64_t size);
     void guarantee_more_attributes(const std::vector<int64_t>& more_capacities);
+    /**
+     * @brief Makes sure that at least size simplices are reserved. The reservation grows
+     * geometrically so that allocating simplices one by one only copies the attributes O(log n)
+     * times.
+     */
     void guarantee_at_least_attributes(int64_t dimension, int64_t size);
     void guarantee_at_least_attributes(const std::vector<int64_t>& at_least_capacities);
+    int64_t reserved_size(int64_t dimension) const;
     bool operator==(const AttributeManager& other) const;
 
     void assert_capacity_valid() const;
@@ -99,6 +142,8 @@ public:
     void pop_scope(bool apply_updates = true);
     void rollback_current_scope();
     void flush_all_scopes();
+    /// every thread uses its own scope stacks while set, see PerThreadAttributeScopeStacks
+    void set_accessed_concurrently(bool value);
 
     void change_to_parent_scope() const;
     void change_to_child_scope() const;
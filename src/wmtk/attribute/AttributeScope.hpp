@@ -49,6 +49,9 @@ private:
     T load_const_cached_scalar_value(const AccessorBase<T>& accessor, int64_t index) const;
 
     AttributeCache<T>& get_cache() { return static_cast<AttributeCache<T>&>(*this); }
+
+    // depth of the scope in its AttributeScopeStack, scopes are only materialized on write
+    int64_t m_depth = 0;
 };
 
 } // namespace attribute
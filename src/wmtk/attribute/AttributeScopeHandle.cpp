@@ -1,9 +1,13 @@
 #include "AttributeScopeHandle.hpp"
 #include "AttributeManager.hpp"
 #include "AttributeScope.hpp"
+
+#include <exception>
+
 namespace wmtk::attribute {
 AttributeScopeHandle::AttributeScopeHandle(AttributeManager& manager)
     : m_manager(manager)
+    , m_uncaught_exceptions(std::uncaught_exceptions())
 {
     m_manager.push_scope();
 }
@@ -13,6 +17,7 @@ AttributeScopeHandle::AttributeScopeHandle(AttributeScopeHandle&& o)
     : m_manager(o.m_manager)
     , m_failed(o.m_failed)
     , m_was_moved(o.m_was_moved)
+    , m_uncaught_exceptions(o.m_uncaught_exceptions)
 {
     o.m_was_moved = true;
 }
@@ -29,6 +34,9 @@ void AttributeScopeHandle::mark_failed()
 AttributeScopeHandle::~AttributeScopeHandle()
 {
     if (!m_was_moved) {
+        if (!m_failed && std::uncaught_exceptions() > m_uncaught_exceptions) {
+            mark_failed();
+        }
         m_manager.pop_scope(!m_failed);
     }
 }
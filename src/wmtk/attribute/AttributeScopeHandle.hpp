@@ -26,7 +26,8 @@ public:
      * @brief Destructor of `AttributeScopeHandle`.
      *
      * Automatically pops the scope for all attributes of the manager. If `mark_failed()` was
-     * called, all changes are discarded, otherwise they are applied to the parent scope.
+     * called or the scope is left by an exception, all changes are discarded, otherwise they are
+     * applied to the parent scope.
      */
     ~AttributeScopeHandle();
 
@@ -42,5 +43,7 @@ private:
     AttributeManager& m_manager;
     bool m_failed = false;
     bool m_was_moved = false;
+    // exceptions in flight when the scope was created
+    int m_uncaught_exceptions = 0;
 };
 } // namespace wmtk::attribute
@@ -22,6 +22,10 @@ class AttributeManager;
  * The stack consists of AttributeScopes which hold all changes applied inside one scope. Whenever a
  * new scope is created, it is pushed to the stack. As soon as an AttributeScopeHandle is
  * destructed, `push_scope` of all Attributes is triggered.
+ *
+ * Scopes are created lazily: pushing a scope only increases the depth of the stack and the
+ * AttributeScope holding the changes is materialized on the first write inside that scope.
+ * Attributes that are not written by an operation therefore never allocate or merge a scope.
  */
 template <typename T>
 class AttributeScopeStack
@@ -77,8 +81,16 @@ public:
 
     /// checks that we are viewing the active state of the attribute
     bool at_current_scope() const;
-    /// applies the diffs from the last scope to the current attribute
+
+    /// number of scopes that were actually written to
+    int64_t materialized_size() const;
+
 private:
+    /// true if the innermost scope was written to
+    bool has_current_scope() const;
+    /// returns the innermost scope, materializing it if nothing was written in it yet
+    AttributeScope<T>& current_scope();
+    /// applies the diffs from the last scope to the current attribute
     void apply_last_scope(Attribute<T>& attr);
     /// apply a particular scope to the current attribute
     void apply_scope(const AttributeScope<T>& scope, Attribute<T>& attr);
@@ -87,17 +99,22 @@ private:
         const;
 
 
-    // current scope is
-
 protected:
+    // only the scopes that were written to, sorted by their depth
     std::vector<AttributeScope<T>> m_scopes;
-    typename std::vector<AttributeScope<T>>::const_iterator m_active;
-    // Mesh& m_mesh;
-    // AttributeManager& m_attribute_manager;
-    // MeshAttributeHandle<T> m_handle;
+    // number of pushed scopes, including the ones that were never materialized
+    int64_t m_depth = 0;
+    // number of scopes we walked towards the parent, 0 means we see the current state
+    int64_t m_parent_steps = 0;
 };
 template <typename T>
 inline int64_t AttributeScopeStack<T>::size() const
+{
+    return m_depth;
+}
+
+template <typename T>
+inline int64_t AttributeScopeStack<T>::materialized_size() const
 {
     return m_scopes.size();
 }
@@ -107,7 +124,11 @@ inline void AttributeScopeStack<T>::rollback_current_scope(Attribute<T>& attr)
 {
     assert(!empty());
     assert(at_current_scope());
-    apply_last_scope(attr);
+    if (has_current_scope()) {
+        apply_last_scope(attr);
+        // the values are restored, there is nothing left to merge into the parent
+        m_scopes.pop_back();
+    }
 }
 
 template <typename T>
@@ -119,7 +140,7 @@ inline auto AttributeScopeStack<T>::vector_attribute(AccessorBase<T, D2>& access
 
     auto data = accessor.template vector_attribute<D>(index);
     if (!empty()) {
-        m_scopes.back().try_caching(index, data);
+        current_scope().try_caching(index, data);
     }
     return data;
 }
@@ -131,14 +152,16 @@ inline auto AttributeScopeStack<T>::const_vector_attribute(
     int64_t index) const -> ConstMapResult<D>
 {
     if (!at_current_scope()) {
-        assert(m_active >= m_scopes.begin());
-        assert(m_active < m_scopes.end());
-        for (auto it = m_active; it < m_scopes.end(); ++it) {
-            // for (auto it = m_active; it < m_scopes.rend(); ++it) {
-            if (auto mapit = it->find_value(index); it->is_value(mapit)) {
-                const auto& d = mapit->second;
-                auto dat = d.template data_as_const_map<D>();
-                return dat;
+        assert(m_parent_steps <= m_depth);
+        // the state at the beginning of the scope at depth first_depth is the oldest value
+        // cached by that scope or any of its children
+        const int64_t first_depth = m_depth - m_parent_steps + 1;
+        for (const AttributeScope<T>& scope : m_scopes) {
+            if (scope.m_depth < first_depth) {
+                continue;
+            }
+            if (const T* cached = scope.find_value(index); cached != nullptr) {
+                return ConstMapResult<D>(cached, accessor.dimension());
             }
         }
     }
@@ -152,7 +175,7 @@ inline auto AttributeScopeStack<T>::scalar_attribute(AccessorBase<T, D2>& access
     assert(writing_enabled());
     T& value = accessor.scalar_attribute(index);
     if (!empty()) {
-        m_scopes.back().try_caching(index, value);
+        current_scope().try_caching(index, value);
     }
     return value;
 }
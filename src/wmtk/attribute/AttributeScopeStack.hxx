@@ -10,7 +10,6 @@ inline AttributeScopeStack<T>::AttributeScopeStack()
 {
     // a random value that's more than 2ish
     m_scopes.reserve(5);
-    m_active = m_scopes.end();
 }
 template <typename T>
 inline AttributeScopeStack<T>::~AttributeScopeStack() = default;
@@ -19,39 +18,51 @@ inline void AttributeScopeStack<T>::emplace()
 {
     assert(at_current_scope()); // must only be called on leaf node
 
-    // create a new leaf that points to the active stack and
-    //
-    if (m_scopes.size() + 1 >= m_scopes.capacity()) {
-        m_scopes.reserve(m_scopes.capacity() + 3);
-        change_to_current_scope();
-    }
-    m_scopes.emplace_back();
-    change_to_current_scope();
+    // the scope itself is only created once something is written in it
+    ++m_depth;
 }
 template <typename T>
 inline void AttributeScopeStack<T>::pop(Attribute<T>& attribute, bool preserve_changes)
 {
     assert(at_current_scope()); // must only be called on leaf node
-    if (!preserve_changes) {
-        // rollback_current_scope(attribute);
-    }
-
+    assert(!empty());
 
-    if (m_scopes.size() >= 2) {
-        auto it = m_scopes.rbegin();
-        auto it2 = it + 1;
-        it->apply_to(*it2);
+    if (has_current_scope()) {
+        const size_t n = m_scopes.size();
+        if (n >= 2 && m_scopes[n - 2].m_depth == m_depth - 1) {
+            m_scopes[n - 1].apply_to(m_scopes[n - 2]);
+            m_scopes.pop_back();
+        } else if (m_depth > 1) {
+            // the parent never wrote anything, it takes over the cache as is
+            m_scopes.back().m_depth = m_depth - 1;
+        } else {
+            m_scopes.pop_back();
+        }
     }
-    m_scopes.pop_back();
-
-    change_to_current_scope();
+    --m_depth;
 }
 
 
 template <typename T>
 inline bool AttributeScopeStack<T>::empty() const
 {
-    return m_scopes.empty();
+    return m_depth == 0;
+}
+
+template <typename T>
+inline bool AttributeScopeStack<T>::has_current_scope() const
+{
+    return !m_scopes.empty() && m_scopes.back().m_depth == m_depth;
+}
+
+template <typename T>
+inline AttributeScope<T>& AttributeScopeStack<T>::current_scope()
+{
+    assert(!empty());
+    if (!has_current_scope()) {
+        m_scopes.emplace_back().m_depth = m_depth;
+    }
+    return m_scopes.back();
 }
 
 
@@ -59,7 +70,7 @@ template <typename T>
 inline void AttributeScopeStack<T>::apply_last_scope(Attribute<T>& attr)
 {
     assert(at_current_scope());
-    assert(!empty());
+    assert(has_current_scope());
     apply_scope(m_scopes.back(), attr);
 }
 template <typename T>
@@ -81,36 +92,25 @@ inline void AttributeScopeStack<T>::apply_scope(
 template <typename T>
 inline void AttributeScopeStack<T>::change_to_previous_scope()
 {
-    // if the previous is a nullptr it's fine
     assert(!at_current_scope());
-    if (m_active == m_scopes.end()) {
-        change_to_current_scope();
-    } else {
-        m_active++;
-    }
+    --m_parent_steps;
 }
 
 template <typename T>
 inline void AttributeScopeStack<T>::change_to_next_scope()
 {
-    if (at_current_scope()) {
-        assert(!empty());
-        assert(m_active == m_scopes.end()); // just making sure the definition doesn't change as
-                                            // this should be m_scopes.end()-1
-        m_active--;
-    } else {
-        m_active--;
-    }
+    assert(m_parent_steps < m_depth);
+    ++m_parent_steps;
 }
 template <typename T>
 inline void AttributeScopeStack<T>::change_to_current_scope()
 {
-    m_active = m_scopes.end();
+    m_parent_steps = 0;
 }
 template <typename T>
 inline bool AttributeScopeStack<T>::at_current_scope() const
 {
-    return m_active == m_scopes.end();
+    return m_parent_steps == 0;
 }
 template <typename T>
 inline bool AttributeScopeStack<T>::writing_enabled() const
@@ -85,7 +85,20 @@ protected:
     const BaseType& base_type() const { return *this; }
 
 private:
-    AttributeScopeStack<T>& m_cache_stack;
+    // the stack bound at construction, the one of the calling thread is only looked up while the
+    // attribute is accessed concurrently (accessors owned by the mesh are shared between threads)
+    AttributeScopeStack<T>& cache_stack()
+    {
+        return attribute().is_accessed_concurrently() ? attribute().get_local_scope_stack()
+                                                      : *m_cache_stack;
+    }
+    const AttributeScopeStack<T>& cache_stack() const
+    {
+        return attribute().is_accessed_concurrently() ? attribute().get_local_scope_stack()
+                                                      : *m_cache_stack;
+    }
+
+    AttributeScopeStack<T>* m_cache_stack;
 };
 } // namespace wmtk::attribute
 #include "CachingAccessor.hxx"
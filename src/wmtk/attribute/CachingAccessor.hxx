@@ -10,12 +10,12 @@ namespace wmtk::attribute {
 template <typename T, int Dim>
 inline CachingAccessor<T,Dim>::CachingAccessor(Mesh& mesh_in, const TypedAttributeHandle<T>& handle)
     : BaseType(mesh_in, handle)
-    , m_cache_stack(attribute().get_local_scope_stack())
+    , m_cache_stack(&attribute().get_serial_scope_stack())
 {}
 template <typename T, int Dim>
 CachingAccessor<T,Dim>::CachingAccessor(const Mesh& mesh_in, const TypedAttributeHandle<T>& handle)
     : BaseType(mesh_in, handle)
-    , m_cache_stack(attribute().get_local_scope_stack())
+    , m_cache_stack(&attribute().get_serial_scope_stack())
 {}
 
 template <typename T, int Dim>
@@ -24,47 +24,47 @@ inline CachingAccessor<T,Dim>::~CachingAccessor() = default;
 template <typename T, int Dim>
 inline bool CachingAccessor<T,Dim>::has_stack() const
 {
-    return !m_cache_stack.empty();
+    return !cache_stack().empty();
 }
 
 template <typename T, int Dim>
 inline bool CachingAccessor<T,Dim>::writing_enabled() const
 {
-    return m_cache_stack.writing_enabled();
+    return cache_stack().writing_enabled();
 }
 
 template <typename T, int Dim>
 inline int64_t CachingAccessor<T,Dim>::stack_depth() const
 {
-    return m_cache_stack.size();
+    return cache_stack().size();
 }
 
 template <typename T, int Dim>
 template <int D>
 inline auto CachingAccessor<T,Dim>::vector_attribute(const int64_t index) -> MapResult<D>
 {
-    return m_cache_stack.template vector_attribute<D>(*this, index);
+    return cache_stack().template vector_attribute<D>(*this, index);
 }
 
 
 template <typename T, int Dim>
 inline auto CachingAccessor<T,Dim>::scalar_attribute(const int64_t index) -> T&
 {
-    return m_cache_stack.scalar_attribute(*this, index);
+    return cache_stack().scalar_attribute(*this, index);
 }
 
 template <typename T, int Dim>
 template <int D>
 inline auto CachingAccessor<T,Dim>::const_vector_attribute(const int64_t index) const -> ConstMapResult<D>
 {
-    return m_cache_stack.template const_vector_attribute<D>(*this, index);
+    return cache_stack().template const_vector_attribute<D>(*this, index);
 }
 
 
 template <typename T, int Dim>
 inline auto CachingAccessor<T,Dim>::const_scalar_attribute(const int64_t index) const -> T
 {
-    return m_cache_stack.const_scalar_attribute(*this, index);
+    return cache_stack().const_scalar_attribute(*this, index);
 }
 
 template <typename T, int Dim>
@@ -81,7 +81,7 @@ inline T CachingAccessor<T,Dim>::scalar_attribute(const int64_t index) const
 template <typename T, int Dim>
 inline auto CachingAccessor<T,Dim>::scalar_attribute(const int64_t index, int8_t offset) -> T&
 {
-    return m_cache_stack.scalar_attribute(*this, index, offset);
+    return cache_stack().scalar_attribute(*this, index, offset);
 }
 
 
@@ -89,7 +89,7 @@ template <typename T, int Dim>
 inline auto CachingAccessor<T,Dim>::const_scalar_attribute(const int64_t index, int8_t offset) const
     -> T
 {
-    return m_cache_stack.const_scalar_attribute(*this, index, offset);
+    return cache_stack().const_scalar_attribute(*this, index, offset);
 }
 
 // template class CachingAccessor<char>;
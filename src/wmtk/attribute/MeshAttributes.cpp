@@ -26,6 +26,27 @@ void MeshAttributes<T>::serialize(const int dim, MeshWriter& writer) const
     }
 }
 
+template <typename T>
+void MeshAttributes<T>::serialize_consolidated(
+    const int dim,
+    MeshWriter& writer,
+    const std::vector<int64_t>& new2old,
+    const std::map<AttributeHandle, std::vector<const std::vector<int64_t>*>>& index_remaps) const
+{
+    static const std::vector<const std::vector<int64_t>*> no_remap;
+    for (const auto& p : m_handles) {
+        const auto& handle = p.second;
+        const auto& attr = *m_attributes[handle.index];
+        const auto it = index_remaps.find(handle);
+        attr.serialize_consolidated(
+            p.first,
+            dim,
+            writer,
+            new2old,
+            it == index_remaps.end() ? no_remap : it->second);
+    }
+}
+
 template <typename T>
 std::map<std::string, std::size_t> MeshAttributes<T>::child_hashes() const
 {
@@ -72,6 +93,13 @@ void MeshAttributes<T>::rollback_current_scope()
     }
 }
 template <typename T>
+void MeshAttributes<T>::set_accessed_concurrently(bool value)
+{
+    for (auto& attr_ptr : m_attributes) {
+        attr_ptr->set_accessed_concurrently(value);
+    }
+}
+template <typename T>
 void MeshAttributes<T>::change_to_parent_scope() const
 {
     for (const auto& attr_ptr : m_attributes) {
@@ -197,15 +225,6 @@ void MeshAttributes<T>::reserve_more(const int64_t size)
     reserve(m_reserved_size + size);
 }
 
-template <typename T>
-void MeshAttributes<T>::guarantee_at_least(const int64_t size)
-{
-    if (size > m_reserved_size) {
-        logger().warn("Pre-reserve enough simplices before your operation.");
-        reserve(size);
-    }
-}
-
 template <typename T>
 void MeshAttributes<T>::remove_attributes(const std::vector<AttributeHandle>& attributes)
 {
@@ -44,6 +44,17 @@ public:
     MeshAttributes& operator=(MeshAttributes&& o) = default;
 
     void serialize(const int dim, MeshWriter& writer) const;
+    /**
+     * @brief Serialize all attributes as if they were consolidated with new2old.
+     * index_remaps holds the per-column old2new maps of the attributes that store indices, see
+     * Attribute::serialize_consolidated.
+     */
+    void serialize_consolidated(
+        const int dim,
+        MeshWriter& writer,
+        const std::vector<int64_t>& new2old,
+        const std::map<AttributeHandle, std::vector<const std::vector<int64_t>*>>& index_remaps)
+        const;
 
     // attribute directly hashes its "child_hashables" components so it overrides "child_hashes"
     std::map<std::string, const wmtk::utils::Hashable*> child_hashables() const override;
@@ -60,8 +71,6 @@ public:
 
     // adds size more simplices to teh existing reservation
     void reserve_more(int64_t size);
-    // makes sure we have at least size simplices reserved
-    void guarantee_at_least(int64_t size);
 
     /**
      * @brief Remove all passed in attributes.
@@ -74,6 +83,7 @@ public:
     void push_scope();
     void pop_scope(bool apply_updates = true);
     void rollback_current_scope();
+    void set_accessed_concurrently(bool value);
 
     void change_to_parent_scope() const;
     void change_to_child_scope() const;
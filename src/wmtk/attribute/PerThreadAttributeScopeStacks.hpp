@@ -1,34 +1,65 @@
 #pragma once
 
+#include <tbb/enumerable_thread_specific.h>
+#include <thread>
 #include "AttributeScopeStack.hpp"
 
 
 namespace wmtk::attribute {
 
+/**
+ * The scope stacks of an attribute, one per thread.
+ *
+ * While the attribute is accessed concurrently every thread pushes, pops and rolls back its own
+ * scopes, so concurrent operations on disjoint parts of a mesh cache their changes independently.
+ * The thread that created the attribute (the one driving the scheduler in practice) gets an inline
+ * stack, other threads get theirs lazily from thread specific storage.
+ *
+ * Otherwise a single thread works on the attribute at a time and the inline stack is used without
+ * looking up the calling thread.
+ */
 template <typename T>
 class PerThreadAttributeScopeStacks
 {
 public:
-    PerThreadAttributeScopeStacks() = default;
+    PerThreadAttributeScopeStacks();
     PerThreadAttributeScopeStacks(PerThreadAttributeScopeStacks&&) = default;
     PerThreadAttributeScopeStacks& operator=(PerThreadAttributeScopeStacks&&) = default;
     AttributeScopeStack<T>& local();
     const AttributeScopeStack<T>& local() const;
+    /// the stack used while the attribute is not accessed concurrently
+    AttributeScopeStack<T>& serial() const { return m_owner_stack; }
+
+    void set_accessed_concurrently(bool value) { m_accessed_concurrently = value; }
+    bool is_accessed_concurrently() const { return m_accessed_concurrently; }
 
 private:
-    // single stack so far
-    mutable AttributeScopeStack<T> m_stack;
+    bool m_accessed_concurrently = false;
+    std::thread::id m_owner;
+    mutable AttributeScopeStack<T> m_owner_stack;
+    mutable tbb::enumerable_thread_specific<AttributeScopeStack<T>> m_stacks;
 };
 
 
+template <typename T>
+inline PerThreadAttributeScopeStacks<T>::PerThreadAttributeScopeStacks()
+    : m_owner(std::this_thread::get_id())
+{}
+
 template <typename T>
 inline AttributeScopeStack<T>& PerThreadAttributeScopeStacks<T>::local()
 {
-    return m_stack;
+    if (!m_accessed_concurrently || std::this_thread::get_id() == m_owner) {
+        return m_owner_stack;
+    }
+    return m_stacks.local();
 }
 template <typename T>
 inline const AttributeScopeStack<T>& PerThreadAttributeScopeStacks<T>::local() const
 {
-    return m_stack;
+    if (!m_accessed_concurrently || std::this_thread::get_id() == m_owner) {
+        return m_owner_stack;
+    }
+    return m_stacks.local();
 }
 } // namespace wmtk::attribute
@@ -0,0 +1,131 @@
+#include "SimplexIdFreeList.hpp"
+
+#include <cassert>
+
+namespace wmtk::attribute {
+
+SimplexIdFreeList::SimplexIdFreeList(int64_t dimension_count)
+    : m_ids(dimension_count)
+    , m_mutex(std::make_unique<std::mutex>())
+    , m_owner(std::this_thread::get_id())
+{}
+
+SimplexIdFreeList::~SimplexIdFreeList() = default;
+
+auto SimplexIdFreeList::local_journal() -> Journal&
+{
+    if (std::this_thread::get_id() == m_owner) {
+        return m_owner_journal;
+    }
+    return m_journals.local();
+}
+
+void SimplexIdFreeList::release(int64_t dimension, int64_t id)
+{
+    Journal& journal = local_journal();
+    if (!journal.scope_starts.empty()) {
+        journal.released.push_back(Entry{dimension, id});
+        return;
+    }
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    m_ids[dimension].push_back(id);
+}
+
+int64_t SimplexIdFreeList::take(int64_t dimension)
+{
+    int64_t id = -1;
+    {
+        std::lock_guard<std::mutex> lock(*m_mutex);
+        std::vector<int64_t>& ids = m_ids[dimension];
+        if (ids.empty()) {
+            return -1;
+        }
+        id = ids.back();
+        ids.pop_back();
+    }
+
+    Journal& journal = local_journal();
+    if (!journal.scope_starts.empty()) {
+        journal.taken.push_back(Entry{dimension, id});
+    }
+    return id;
+}
+
+void SimplexIdFreeList::track_new(int64_t dimension, int64_t id)
+{
+    Journal& journal = local_journal();
+    if (!journal.scope_starts.empty()) {
+        journal.taken.push_back(Entry{dimension, id});
+    }
+}
+
+int64_t SimplexIdFreeList::size(int64_t dimension) const
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    return m_ids[dimension].size();
+}
+
+std::vector<int64_t> SimplexIdFreeList::ids(int64_t dimension) const
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    return m_ids[dimension];
+}
+
+void SimplexIdFreeList::clear()
+{
+    std::lock_guard<std::mutex> lock(*m_mutex);
+    for (std::vector<int64_t>& ids : m_ids) {
+        ids.clear();
+    }
+}
+
+void SimplexIdFreeList::push_scope()
+{
+    Journal& journal = local_journal();
+    journal.scope_starts.push_back({{journal.released.size(), journal.taken.size()}});
+}
+
+void SimplexIdFreeList::pop_scope(bool apply_updates)
+{
+    Journal& journal = local_journal();
+    assert(!journal.scope_starts.empty());
+    if (!apply_updates) {
+        rollback_current_scope();
+    }
+    journal.scope_starts.pop_back();
+
+    // the changes of a nested scope belong to its parent now
+    if (!journal.scope_starts.empty()) {
+        return;
+    }
+    if (!journal.released.empty()) {
+        std::lock_guard<std::mutex> lock(*m_mutex);
+        for (const Entry& e : journal.released) {
+            m_ids[e.dimension].push_back(e.id);
+        }
+    }
+    journal.released.clear();
+    journal.taken.clear();
+}
+
+void SimplexIdFreeList::rollback_current_scope()
+{
+    Journal& journal = local_journal();
+    assert(!journal.scope_starts.empty());
+    const auto [released_start, taken_start] = journal.scope_starts.back();
+
+    // the simplices released in this scope are alive again
+    journal.released.resize(released_start);
+
+    // and the ones that were taken are deleted again
+    if (journal.taken.size() > taken_start) {
+        std::lock_guard<std::mutex> lock(*m_mutex);
+        for (size_t j = taken_start; j < journal.taken.size(); ++j) {
+            const Entry& e = journal.taken[j];
+            m_ids[e.dimension].push_back(e.id);
+        }
+    }
+    journal.taken.resize(taken_start);
+}
+
+} // namespace wmtk::attribute
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <tbb/enumerable_thread_specific.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wmtk::attribute {
+
+/**
+ * Ids of deleted simplices, per dimension, that can be handed out again to new simplices.
+ *
+ * The lists follow the attribute scopes. Ids released inside a scope only become available once
+ * the outermost scope is applied, so an operation never reuses the simplices it deletes and a
+ * rollback never resurrects a simplex that was already handed out to someone else. Ids taken
+ * inside a scope are returned when that scope is rolled back, just like their flags.
+ *
+ * Every thread journals its own scopes (see PerThreadAttributeScopeStacks), the lists themselves
+ * are shared between the threads.
+ */
+class SimplexIdFreeList
+{
+public:
+    SimplexIdFreeList(int64_t dimension_count);
+    SimplexIdFreeList(SimplexIdFreeList&&) = default;
+    SimplexIdFreeList& operator=(SimplexIdFreeList&&) = default;
+    ~SimplexIdFreeList();
+
+    /**
+     * @brief The simplex was deleted, its id can be reused once the current scope is applied.
+     */
+    void release(int64_t dimension, int64_t id);
+    /**
+     * @brief Takes an id that can be reused, or returns -1 if there is none.
+     */
+    int64_t take(int64_t dimension);
+    /**
+     * @brief A new id past the capacity was handed out. Like the taken ones it is put into the
+     * list if the current scope is rolled back, as the simplex is deleted again.
+     */
+    void track_new(int64_t dimension, int64_t id);
+    /**
+     * @brief The number of ids that can be reused right now.
+     */
+    int64_t size(int64_t dimension) const;
+    /**
+     * @brief The ids that can be reused right now, in no particular order.
+     */
+    std::vector<int64_t> ids(int64_t dimension) const;
+    /**
+     * @brief Forgets all ids, e.g. because consolidate removed the deleted simplices.
+     */
+    void clear();
+
+    void push_scope();
+    void pop_scope(bool apply_updates);
+    void rollback_current_scope();
+
+private:
+    struct Entry
+    {
+        int64_t dimension;
+        int64_t id;
+    };
+    struct Journal
+    {
+        std::vector<Entry> released;
+        // the taken and the new ids
+        std::vector<Entry> taken;
+        // sizes of released and taken when each open scope was pushed
+        std::vector<std::array<size_t, 2>> scope_starts;
+    };
+
+    Journal& local_journal();
+
+    std::vector<std::vector<int64_t>> m_ids;
+    std::unique_ptr<std::mutex> m_mutex;
+
+    std::thread::id m_owner;
+    Journal m_owner_journal;
+    tbb::enumerable_thread_specific<Journal> m_journals;
+};
+
+} // namespace wmtk::attribute
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace wmtk::attribute::internal {
+
+/**
+ * Flat storage for the values cached by an AttributeCache.
+ *
+ * Every cached value lives in a single contiguous arena (dimension values per entry, in
+ * insertion order) and indices are looked up with a linear scan while the cache is small or
+ * through an open addressing table once it grows. Clearing keeps the memory around so a reused
+ * cache does not allocate again.
+ */
+template <typename T>
+class FlatCacheStorage
+{
+public:
+    FlatCacheStorage() = default;
+    FlatCacheStorage(FlatCacheStorage&&) = default;
+    FlatCacheStorage& operator=(FlatCacheStorage&&) = default;
+    FlatCacheStorage(const FlatCacheStorage&) = delete;
+    FlatCacheStorage& operator=(const FlatCacheStorage&) = delete;
+
+    /// returns the cached value of index or nullptr if it is not cached
+    const T* find(int64_t index) const;
+
+    /**
+     * @brief adds index to the cache if it is not there yet
+     * @return the storage of the value and whether it was inserted (and must be filled)
+     */
+    std::pair<T*, bool> try_emplace(int64_t index, int64_t dimension);
+
+    void clear();
+    size_t size() const { return m_indices.size(); }
+    int64_t dimension() const { return m_dimension; }
+
+    /// calls func(index, const T* value) on every entry in insertion order
+    template <typename Func>
+    void for_each(Func&& func) const;
+
+private:
+    // below this many entries a linear scan beats hashing
+    constexpr static size_t linear_search_size = 16;
+
+    int64_t find_entry(int64_t index) const;
+    size_t slot(int64_t index) const;
+    void rebuild_table(size_t slot_count);
+
+    std::vector<int64_t> m_indices;
+    std::vector<T> m_values;
+    // entry id for every slot of the open addressing table, -1 marks an empty slot
+    std::vector<int64_t> m_table;
+    int64_t m_dimension = 0;
+};
+
+} // namespace wmtk::attribute::internal
+
+#include "FlatCacheStorage.hxx"
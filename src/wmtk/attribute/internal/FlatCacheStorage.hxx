@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include "FlatCacheStorage.hpp"
+
+namespace wmtk::attribute::internal {
+
+template <typename T>
+inline size_t FlatCacheStorage<T>::slot(int64_t index) const
+{
+    // fibonacci hashing, the table size is a power of 2
+    const uint64_t h = static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> 32) & (m_table.size() - 1);
+}
+
+template <typename T>
+inline int64_t FlatCacheStorage<T>::find_entry(int64_t index) const
+{
+    if (m_table.empty()) {
+        const auto it = std::find(m_indices.begin(), m_indices.end(), index);
+        return it == m_indices.end() ? -1 : std::distance(m_indices.begin(), it);
+    }
+    for (size_t s = slot(index);; s = (s + 1) & (m_table.size() - 1)) {
+        const int64_t entry = m_table[s];
+        if (entry == -1 || m_indices[entry] == index) {
+            return entry;
+        }
+    }
+}
+
+template <typename T>
+inline const T* FlatCacheStorage<T>::find(int64_t index) const
+{
+    const int64_t entry = find_entry(index);
+    return entry == -1 ? nullptr : m_values.data() + entry * m_dimension;
+}
+
+template <typename T>
+inline std::pair<T*, bool> FlatCacheStorage<T>::try_emplace(int64_t index, int64_t dimension)
+{
+    assert(m_indices.empty() || m_dimension == dimension);
+    m_dimension = dimension;
+
+    if (const int64_t entry = find_entry(index); entry != -1) {
+        return {m_values.data() + entry * m_dimension, false};
+    }
+
+    const int64_t entry = m_indices.size();
+    m_indices.emplace_back(index);
+    m_values.resize(m_indices.size() * m_dimension);
+
+    if (m_indices.size() > linear_search_size) {
+        // keep the load factor below 1/2
+        if (2 * m_indices.size() > m_table.size()) {
+            rebuild_table(std::max<size_t>(4 * linear_search_size, 2 * m_table.size()));
+        } else {
+            size_t s = slot(index);
+            while (m_table[s] != -1) {
+                s = (s + 1) & (m_table.size() - 1);
+            }
+            m_table[s] = entry;
+        }
+    }
+    return {m_values.data() + entry * m_dimension, true};
+}
+
+template <typename T>
+inline void FlatCacheStorage<T>::rebuild_table(size_t slot_count)
+{
+    m_table.assign(slot_count, -1);
+    for (int64_t entry = 0; entry < int64_t(m_indices.size()); ++entry) {
+        size_t s = slot(m_indices[entry]);
+        while (m_table[s] != -1) {
+            s = (s + 1) & (m_table.size() - 1);
+        }
+        m_table[s] = entry;
+    }
+}
+
+template <typename T>
+inline void FlatCacheStorage<T>::clear()
+{
+    m_indices.clear();
+    m_values.clear();
+    m_table.clear();
+}
+
+template <typename T>
+template <typename Func>
+inline void FlatCacheStorage<T>::for_each(Func&& func) const
+{
+    for (size_t entry = 0; entry < m_indices.size(); ++entry) {
+        func(m_indices[entry], m_values.data() + entry * m_dimension);
+    }
+}
+
+} // namespace wmtk::attribute::internal
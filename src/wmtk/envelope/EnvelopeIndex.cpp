@@ -0,0 +1,78 @@
+#include "EnvelopeIndex.hpp"
+
+#include <wmtk/Mesh.hpp>
+#include <wmtk/simplex/faces_single_dimension.hpp>
+#include <wmtk/utils/Logger.hpp>
+
+#include <fastenvelope/FastEnvelope.h>
+#include <SimpleBVH/BVH.hpp>
+
+namespace wmtk::envelope {
+
+EnvelopeIndex::EnvelopeIndex(const attribute::MeshAttributeHandle& envelope_mesh_coordinate)
+    : m_coordinate_handle(envelope_mesh_coordinate)
+    , m_facet_type(envelope_mesh_coordinate.mesh().top_simplex_type())
+{
+    const Mesh& envelope_mesh = envelope_mesh_coordinate.mesh();
+    const attribute::Accessor<double> accessor =
+        envelope_mesh.create_const_accessor(envelope_mesh_coordinate.as<double>());
+
+    // compact the vertex ids, every vertex is stored once
+    const std::vector<Tuple> vertices = envelope_mesh.get_all(PrimitiveType::Vertex);
+    std::vector<int> old2new(envelope_mesh.capacity(PrimitiveType::Vertex), -1);
+    m_vertices.resize(vertices.size(), accessor.dimension());
+    for (int64_t i = 0; i < int64_t(vertices.size()); ++i) {
+        old2new[envelope_mesh.id(vertices[i], PrimitiveType::Vertex)] = i;
+        m_vertices.row(i) = accessor.const_vector_attribute(vertices[i]).transpose();
+    }
+
+    const std::vector<Tuple> facets = envelope_mesh.get_all(m_facet_type);
+    const int64_t dim = envelope_mesh.top_cell_dimension() + 1;
+    m_facets.resize(facets.size(), dim);
+    for (int64_t i = 0; i < int64_t(facets.size()); ++i) {
+        const std::vector<Tuple> fv = simplex::faces_single_dimension_tuples(
+            envelope_mesh,
+            simplex::Simplex(m_facet_type, facets[i]),
+            PrimitiveType::Vertex);
+        assert(fv.size() == dim);
+        for (int64_t j = 0; j < dim; ++j) {
+            m_facets(i, j) = old2new[envelope_mesh.id(fv[j], PrimitiveType::Vertex)];
+        }
+    }
+}
+
+EnvelopeIndex::~EnvelopeIndex() = default;
+
+std::shared_ptr<SimpleBVH::BVH> EnvelopeIndex::bvh() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_bvh) {
+        m_bvh = std::make_shared<SimpleBVH::BVH>();
+        m_bvh->init(m_vertices, m_facets, 1e-10);
+    }
+    return m_bvh;
+}
+
+std::shared_ptr<fastEnvelope::FastEnvelope> EnvelopeIndex::fast_envelope(double envelope_size) const
+{
+    if (m_facet_type != PrimitiveType::Triangle || m_vertices.cols() != 3) {
+        log_and_throw_error("Fast envelope works only for triangle meshes in 3d");
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<fastEnvelope::FastEnvelope>& envelope = m_fast_envelopes[envelope_size];
+    if (!envelope) {
+        std::vector<Eigen::Vector3d> vertices(m_vertices.rows());
+        for (int64_t i = 0; i < m_vertices.rows(); ++i) {
+            vertices[i] = m_vertices.row(i).transpose();
+        }
+        std::vector<Eigen::Vector3i> faces(m_facets.rows());
+        for (int64_t i = 0; i < m_facets.rows(); ++i) {
+            faces[i] = m_facets.row(i).transpose();
+        }
+        envelope = std::make_shared<fastEnvelope::FastEnvelope>(vertices, faces, envelope_size);
+    }
+    return envelope;
+}
+
+} // namespace wmtk::envelope
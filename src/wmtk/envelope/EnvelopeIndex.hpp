@@ -0,0 +1,64 @@
+#pragma once
+
+#include <wmtk/attribute/MeshAttributeHandle.hpp>
+
+#include <Eigen/Core>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace fastEnvelope {
+class FastEnvelope;
+}
+namespace SimpleBVH {
+class BVH;
+}
+
+namespace wmtk::envelope {
+
+/**
+ * The geometry of an envelope mesh, shared by everything that queries it, e.g. EnvelopeInvariant
+ * and ProjectOperation. Hold it in a shared_ptr and hand the same index to all of them.
+ *
+ * The vertices are stored once and the facets index into them. The BVH and the fast envelopes
+ * are built on first use and then shared by all the users of the index.
+ */
+class EnvelopeIndex
+{
+public:
+    /**
+     * @param envelope_mesh_coordinate the vertex positions of the envelope mesh
+     */
+    EnvelopeIndex(const attribute::MeshAttributeHandle& envelope_mesh_coordinate);
+    ~EnvelopeIndex();
+    EnvelopeIndex(const EnvelopeIndex&) = delete;
+    EnvelopeIndex& operator=(const EnvelopeIndex&) = delete;
+
+    const attribute::MeshAttributeHandle& coordinate_handle() const { return m_coordinate_handle; }
+    // the top simplex type of the envelope mesh
+    PrimitiveType facet_type() const { return m_facet_type; }
+
+    // one row per vertex of the envelope mesh
+    const Eigen::MatrixXd& vertices() const { return m_vertices; }
+    // one row per top simplex of the envelope mesh, indexing the rows of vertices
+    const Eigen::MatrixXi& facets() const { return m_facets; }
+
+    std::shared_ptr<SimpleBVH::BVH> bvh() const;
+    /**
+     * @brief The fast envelope of the given thickness, only for triangle meshes in 3d.
+     */
+    std::shared_ptr<fastEnvelope::FastEnvelope> fast_envelope(double envelope_size) const;
+
+private:
+    attribute::MeshAttributeHandle m_coordinate_handle;
+    PrimitiveType m_facet_type;
+    Eigen::MatrixXd m_vertices;
+    Eigen::MatrixXi m_facets;
+
+    mutable std::mutex m_mutex;
+    mutable std::shared_ptr<SimpleBVH::BVH> m_bvh;
+    mutable std::map<double, std::shared_ptr<fastEnvelope::FastEnvelope>> m_fast_envelopes;
+};
+
+} // namespace wmtk::envelope
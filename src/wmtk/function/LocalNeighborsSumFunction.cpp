@@ -36,13 +36,7 @@ double LocalNeighborsSumFunction::get_value(const simplex::Simplex& variable_sim
     assert(mesh() == m_function.mesh());
     // assert(attribute_handle() == m_function.attribute_handle());
 
-    double res = 0;
-    for (const simplex::Simplex& cell : neighs) {
-        assert(cell.primitive_type() == m_domain_simplex_type);
-        res += m_function.get_value(cell);
-    }
-
-    return res;
+    return m_function.get_value_sum(neighs, variable_simplex);
 }
 
 Eigen::VectorXd LocalNeighborsSumFunction::get_gradient(
@@ -54,14 +48,14 @@ Eigen::VectorXd LocalNeighborsSumFunction::get_gradient(
     assert(mesh() == m_function.mesh());
     // assert(attribute_handle() == m_function.attribute_handle());
 
-    Eigen::VectorXd res = Eigen::VectorXd::Zero(embedded_dimension());
+    assert(embedded_dimension() <= 3);
+    // accumulate in fixed size storage, the closed form functions add to it without allocating,
+    // and the whole neighborhood goes to the function at once so that it can batch it
+    Eigen::Matrix<double, 3, 1> res = Eigen::Matrix<double, 3, 1>::Zero();
 
-    for (const simplex::Simplex& cell : neighs) {
-        assert(cell.primitive_type() == m_domain_simplex_type);
-        res += m_function.get_gradient(cell, variable_simplex);
-    }
+    m_function.add_gradient_sum(neighs, variable_simplex, res);
 
-    return res;
+    return res.head(embedded_dimension());
 }
 
 Eigen::MatrixXd LocalNeighborsSumFunction::get_hessian(
@@ -73,14 +67,13 @@ Eigen::MatrixXd LocalNeighborsSumFunction::get_hessian(
     assert(mesh() == m_function.mesh());
     // assert(attribute_handle() == m_function.attribute_handle());
 
-    Eigen::MatrixXd res = Eigen::MatrixXd::Zero(embedded_dimension(), embedded_dimension());
+    assert(embedded_dimension() <= 3);
+    Eigen::Matrix<double, 3, 3> res = Eigen::Matrix<double, 3, 3>::Zero();
 
-    for (const simplex::Simplex& cell : neighs) {
-        assert(cell.primitive_type() == m_domain_simplex_type);
-        res += m_function.get_hessian(cell, variable_simplex);
-    }
+    m_function.add_hessian_sum(neighs, variable_simplex, res);
 
-    return res;
+    const int64_t dim = embedded_dimension();
+    return res.topLeftCorner(dim, dim);
 }
 
 } // namespace wmtk::function
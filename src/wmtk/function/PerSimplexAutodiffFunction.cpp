@@ -20,8 +20,7 @@ std::vector<PerSimplexAutodiffFunction::DSVec> PerSimplexAutodiffFunction::get_c
     const simplex::Simplex& domain_simplex,
     const std::optional<simplex::Simplex>& variable_simplex_opt) const
 {
-    const attribute::Accessor<double> pos = mesh().create_const_accessor(attribute_handle().as<double>());
-    return get_coordinates(pos, domain_simplex, variable_simplex_opt);
+    return get_coordinates(coordinate_accessor(), domain_simplex, variable_simplex_opt);
 }
 
 std::vector<PerSimplexAutodiffFunction::DSVec> PerSimplexAutodiffFunction::get_coordinates(
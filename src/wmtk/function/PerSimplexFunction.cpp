@@ -9,6 +9,7 @@ PerSimplexFunction::PerSimplexFunction(
     const attribute::MeshAttributeHandle& variable_attribute_handle)
     : m_handle(variable_attribute_handle)
     , m_mesh(mesh)
+    , m_coordinate_accessor(mesh.create_const_accessor(variable_attribute_handle.as<double>()))
     , m_primitive_type(primitive_type)
 {
     assert(variable_attribute_handle.is_same_mesh(m_mesh));
@@ -22,4 +23,55 @@ int64_t PerSimplexFunction::embedded_dimension() const
     assert(res > 0);
     return res;
 }
+
+void PerSimplexFunction::add_gradient(
+    const simplex::Simplex& domain_simplex,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Matrix<double, 3, 1>& gradient) const
+{
+    const Eigen::VectorXd g = get_gradient(domain_simplex, variable_simplex);
+    assert(g.size() <= 3);
+    gradient.head(g.size()) += g;
+}
+
+void PerSimplexFunction::add_hessian(
+    const simplex::Simplex& domain_simplex,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Matrix<double, 3, 3>& hessian) const
+{
+    const Eigen::MatrixXd h = get_hessian(domain_simplex, variable_simplex);
+    assert(h.rows() <= 3 && h.cols() == h.rows());
+    hessian.topLeftCorner(h.rows(), h.cols()) += h;
+}
+
+double PerSimplexFunction::get_value_sum(
+    const std::vector<simplex::Simplex>& domain_simplices,
+    const simplex::Simplex& variable_simplex) const
+{
+    double res = 0;
+    for (const simplex::Simplex& s : domain_simplices) {
+        res += get_value(s);
+    }
+    return res;
+}
+
+void PerSimplexFunction::add_gradient_sum(
+    const std::vector<simplex::Simplex>& domain_simplices,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Matrix<double, 3, 1>& gradient) const
+{
+    for (const simplex::Simplex& s : domain_simplices) {
+        add_gradient(s, variable_simplex, gradient);
+    }
+}
+
+void PerSimplexFunction::add_hessian_sum(
+    const std::vector<simplex::Simplex>& domain_simplices,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Matrix<double, 3, 3>& hessian) const
+{
+    for (const simplex::Simplex& s : domain_simplices) {
+        add_hessian(s, variable_simplex, hessian);
+    }
+}
 } // namespace wmtk::function
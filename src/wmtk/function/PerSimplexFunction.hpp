@@ -2,6 +2,7 @@
 
 #include <wmtk/Primitive.hpp>
 
+#include <wmtk/attribute/Accessor.hpp>
 #include <wmtk/attribute/MeshAttributes.hpp>
 
 #include <Eigen/Core>
@@ -38,6 +39,40 @@ public:
         throw std::runtime_error("Hessian not implemented");
     }
 
+    /**
+     * @brief Adds the gradient wrt variable_simplex to the first embedded_dimension() entries of
+     * gradient. Functions with a closed form override this to skip the dynamic sized get_gradient.
+     */
+    virtual void add_gradient(
+        const simplex::Simplex& domain_simplex,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 1>& gradient) const;
+
+    /**
+     * @brief Adds the hessian wrt variable_simplex to the top left embedded_dimension() block of
+     * hessian, see add_gradient.
+     */
+    virtual void add_hessian(
+        const simplex::Simplex& domain_simplex,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 3>& hessian) const;
+
+    /**
+     * @brief The sums of get_value, add_gradient and add_hessian over domain_simplices, which all
+     * contain variable_simplex. Functions that evaluate a whole neighborhood at once override them.
+     */
+    virtual double get_value_sum(
+        const std::vector<simplex::Simplex>& domain_simplices,
+        const simplex::Simplex& variable_simplex) const;
+    virtual void add_gradient_sum(
+        const std::vector<simplex::Simplex>& domain_simplices,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 1>& gradient) const;
+    virtual void add_hessian_sum(
+        const std::vector<simplex::Simplex>& domain_simplices,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 3>& hessian) const;
+
     inline const Mesh& mesh() const { return m_mesh; }
     inline const attribute::MeshAttributeHandle& attribute_handle() const
     {
@@ -47,9 +82,16 @@ public:
 
     int64_t embedded_dimension() const;
 
+    /// accessor to the variable attribute, created once with the function
+    inline const attribute::Accessor<double>& coordinate_accessor() const
+    {
+        return m_coordinate_accessor;
+    }
+
 private:
     attribute::MeshAttributeHandle m_handle;
     const Mesh& m_mesh;
+    const attribute::Accessor<double> m_coordinate_accessor;
 
 protected:
     const PrimitiveType m_primitive_type;
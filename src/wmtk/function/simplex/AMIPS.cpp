@@ -1,7 +1,9 @@
 #include "AMIPS.hpp"
 
 #include <wmtk/Mesh.hpp>
+#include <wmtk/TetMesh.hpp>
 #include <wmtk/function/utils/SimplexGetter.hpp>
+#include <wmtk/function/utils/amips_one_ring.hpp>
 #include <wmtk/utils/Rational.hpp>
 #include <wmtk/simplex/Simplex.hpp>
 
@@ -587,12 +589,9 @@ std::array<double, NV * DIM> AMIPS::get_raw_coordinates(
     const std::optional<simplex::Simplex>& variable_simplex) const
 {
     if (embedded_dimension() != DIM) throw std::runtime_error("AMIPS wrong dimension");
-    const attribute::Accessor<double> accessor =
-        mesh().create_const_accessor(attribute_handle().as<double>());
-
     auto [attrs, index] = utils::get_simplex_attributes(
         mesh(),
-        accessor,
+        coordinate_accessor(),
         m_primitive_type,
         domain_simplex,
         variable_simplex.has_value() ? variable_simplex->tuple() : std::optional<Tuple>());
@@ -625,33 +624,124 @@ double AMIPS::get_value(const simplex::Simplex& domain_simplex) const
 Eigen::VectorXd AMIPS::get_gradient(
     const simplex::Simplex& domain_simplex,
     const simplex::Simplex& variable_simplex) const
+{
+    Eigen::Vector3d res = Eigen::Vector3d::Zero();
+    add_gradient(domain_simplex, variable_simplex, res);
+    return res.head(domain_simplex.primitive_type() == PrimitiveType::Tetrahedron ? 3 : 2);
+}
+
+Eigen::MatrixXd AMIPS::get_hessian(
+    const simplex::Simplex& domain_simplex,
+    const simplex::Simplex& variable_simplex) const
+{
+    Eigen::Matrix3d res = Eigen::Matrix3d::Zero();
+    add_hessian(domain_simplex, variable_simplex, res);
+    const int64_t dim = domain_simplex.primitive_type() == PrimitiveType::Tetrahedron ? 3 : 2;
+    return res.topLeftCorner(dim, dim);
+}
+
+void AMIPS::add_gradient(
+    const simplex::Simplex& domain_simplex,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Vector3d& gradient) const
 {
     if (domain_simplex.primitive_type() == PrimitiveType::Tetrahedron) {
         Eigen::Vector3d res;
         Tet_AMIPS_jacobian(get_raw_coordinates<4, 3>(domain_simplex, variable_simplex), res);
-        return res;
+        gradient += res;
     } else if (domain_simplex.primitive_type() == PrimitiveType::Triangle) {
         Eigen::Vector2d res;
         Tri_AMIPS_jacobian(get_raw_coordinates<3, 2>(domain_simplex, variable_simplex), res);
-        return res;
+        gradient.head<2>() += res;
     } else
         throw std::runtime_error("AMIPS wrong simplex type");
 }
 
-Eigen::MatrixXd AMIPS::get_hessian(
+void AMIPS::add_hessian(
     const simplex::Simplex& domain_simplex,
-    const simplex::Simplex& variable_simplex) const
+    const simplex::Simplex& variable_simplex,
+    Eigen::Matrix3d& hessian) const
 {
     if (domain_simplex.primitive_type() == PrimitiveType::Tetrahedron) {
         Eigen::Matrix3d res;
         Tet_AMIPS_hessian(get_raw_coordinates<4, 3>(domain_simplex, variable_simplex), res);
-        return res;
+        hessian += res;
     } else if (domain_simplex.primitive_type() == PrimitiveType::Triangle) {
         Eigen::Matrix2d res;
         Tri_AMIPS_hessian(get_raw_coordinates<3, 2>(domain_simplex, variable_simplex), res);
-        return res;
+        hessian.topLeftCorner<2, 2>() += res;
     } else
         throw std::runtime_error("AMIPS wrong simplex type");
 }
 
+std::optional<double> AMIPS::evaluate_one_ring(
+    const std::vector<simplex::Simplex>& domain_simplices,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Vector3d* gradient,
+    Eigen::Matrix3d* hessian) const
+{
+    if (mesh().top_simplex_type() != PrimitiveType::Tetrahedron || embedded_dimension() != 3 ||
+        variable_simplex.primitive_type() != PrimitiveType::Vertex) {
+        return {};
+    }
+    const TetMesh& m = static_cast<const TetMesh&>(mesh());
+    const attribute::CachingAccessor<double>& accessor = coordinate_accessor().index_access();
+
+    // reused between calls, smoothing evaluates many rings per thread
+    thread_local utils::TetOneRing ring;
+
+    const int64_t center = m.id_vertex(variable_simplex.tuple());
+    ring.clear(accessor.const_vector_attribute<3>(center));
+    for (const simplex::Simplex& tet : domain_simplices) {
+        assert(tet.primitive_type() == PrimitiveType::Tetrahedron);
+        const auto tv = m.m_tv_accessor->const_vector_attribute<4>(tet.tuple());
+        std::array<int64_t, 3> others;
+        int64_t n = 0;
+        for (int64_t j = 0; j < 4; ++j) {
+            if (tv[j] != center) {
+                assert(n < 3);
+                others[n++] = tv[j];
+            }
+        }
+        assert(n == 3);
+        ring.push_back(
+            accessor.const_vector_attribute<3>(others[0]),
+            accessor.const_vector_attribute<3>(others[1]),
+            accessor.const_vector_attribute<3>(others[2]));
+    }
+
+    return utils::Tet_AMIPS_one_ring(ring, gradient, hessian);
+}
+
+double AMIPS::get_value_sum(
+    const std::vector<simplex::Simplex>& domain_simplices,
+    const simplex::Simplex& variable_simplex) const
+{
+    if (const auto res = evaluate_one_ring(domain_simplices, variable_simplex, nullptr, nullptr);
+        res.has_value()) {
+        return res.value();
+    }
+    return PerSimplexFunction::get_value_sum(domain_simplices, variable_simplex);
+}
+
+void AMIPS::add_gradient_sum(
+    const std::vector<simplex::Simplex>& domain_simplices,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Vector3d& gradient) const
+{
+    if (!evaluate_one_ring(domain_simplices, variable_simplex, &gradient, nullptr).has_value()) {
+        PerSimplexFunction::add_gradient_sum(domain_simplices, variable_simplex, gradient);
+    }
+}
+
+void AMIPS::add_hessian_sum(
+    const std::vector<simplex::Simplex>& domain_simplices,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Matrix3d& hessian) const
+{
+    if (!evaluate_one_ring(domain_simplices, variable_simplex, nullptr, &hessian).has_value()) {
+        PerSimplexFunction::add_hessian_sum(domain_simplices, variable_simplex, hessian);
+    }
+}
+
 } // namespace wmtk::function
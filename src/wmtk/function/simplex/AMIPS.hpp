@@ -30,7 +30,41 @@ public:
         const simplex::Simplex& domain_simplex,
         const simplex::Simplex& variable_simplex) const override;
 
+    // the generated closed form kernels, written straight into the fixed size outputs
+    void add_gradient(
+        const simplex::Simplex& domain_simplex,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 1>& gradient) const override;
+    void add_hessian(
+        const simplex::Simplex& domain_simplex,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 3>& hessian) const override;
+
+    // the tets around a vertex are gathered once and evaluated in lane groups
+    double get_value_sum(
+        const std::vector<simplex::Simplex>& domain_simplices,
+        const simplex::Simplex& variable_simplex) const override;
+    void add_gradient_sum(
+        const std::vector<simplex::Simplex>& domain_simplices,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 1>& gradient) const override;
+    void add_hessian_sum(
+        const std::vector<simplex::Simplex>& domain_simplices,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 3>& hessian) const override;
+
 private:
+    /**
+     * @brief Evaluates the tets of domain_simplices around the vertex variable_simplex with
+     * utils::Tet_AMIPS_one_ring, adding the derivatives to the non null outputs. Returns nothing if
+     * they are not the tets of a tet mesh in 3d, to be evaluated one by one.
+     */
+    std::optional<double> evaluate_one_ring(
+        const std::vector<simplex::Simplex>& domain_simplices,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 1>* gradient,
+        Eigen::Matrix<double, 3, 3>* hessian) const;
+
     template <int64_t NV, int64_t DIM>
     std::array<double, NV * DIM> get_raw_coordinates(
         const simplex::Simplex& domain_simplex,
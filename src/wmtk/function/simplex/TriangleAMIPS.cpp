@@ -3,8 +3,12 @@
 #include <wmtk/Primitive.hpp>
 #include <wmtk/TriMesh.hpp>
 #include <wmtk/function/utils/AutoDiffRAII.hpp>
+#include <wmtk/function/utils/SimplexGetter.hpp>
 #include <wmtk/function/utils/amips.hpp>
 
+#include <cmath>
+#include <limits>
+
 namespace wmtk::function {
 TriangleAMIPS::TriangleAMIPS(
     const TriMesh& mesh,
@@ -14,6 +18,149 @@ TriangleAMIPS::TriangleAMIPS(
 
 TriangleAMIPS::~TriangleAMIPS() = default;
 
+namespace {
+/**
+ * utils::amips in closed form. With the equilateral target triangle the energy of (p, q, r) is the
+ * sum of the squared edge lengths over sqrt(3) s, where s is twice the area (signed in 2d). The
+ * derivatives are taken wrt p and added to the non null outputs.
+ */
+template <int Dim>
+double amips_closed_form(
+    const Eigen::Matrix<double, Dim, 1>& p,
+    const Eigen::Matrix<double, Dim, 1>& q,
+    const Eigen::Matrix<double, Dim, 1>& r,
+    Eigen::Matrix<double, 3, 1>* gradient,
+    Eigen::Matrix<double, 3, 3>* hessian)
+{
+    using Vec = Eigen::Matrix<double, Dim, 1>;
+    using Mat = Eigen::Matrix<double, Dim, Dim>;
+    static const double sqrt3 = std::sqrt(3.);
+
+    const Vec a = q - p;
+    const Vec b = r - p;
+    const Vec d = q - r; // s is affine in p along d
+
+    double s;
+    Vec grad_s;
+    Mat hess_s;
+    if constexpr (Dim == 2) {
+        s = a.x() * b.y() - a.y() * b.x();
+        grad_s = Vec(d.y(), -d.x());
+        hess_s.setZero();
+    } else {
+        const Eigen::Vector3d n = a.cross(b);
+        s = n.norm();
+        if (s > 0) {
+            grad_s = d.cross(n) / s;
+            hess_s = (d.squaredNorm() * Mat::Identity() - d * d.transpose() -
+                      grad_s * grad_s.transpose()) /
+                     s;
+        }
+    }
+
+    // degenerate, infinite energy with vanishing derivatives as in the autodiff encoding
+    if (std::abs(sqrt3 * s) < std::numeric_limits<double>::denorm_min()) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    const double L = a.squaredNorm() + b.squaredNorm() + d.squaredNorm();
+    const double energy = L / (sqrt3 * s);
+    if (gradient == nullptr && hessian == nullptr) {
+        return energy;
+    }
+
+    const Vec grad_L = -2 * (a + b);
+    const Vec grad = (grad_L - sqrt3 * energy * grad_s) / (sqrt3 * s);
+    if (gradient != nullptr) {
+        gradient->template head<Dim>() += grad;
+    }
+    if (hessian != nullptr) {
+        // differentiating sqrt3 s E = L twice
+        const Mat hess = (4 * Mat::Identity() - sqrt3 * (grad_s * grad.transpose() +
+                                                         grad * grad_s.transpose() +
+                                                         energy * hess_s)) /
+                         (sqrt3 * s);
+        hessian->template topLeftCorner<Dim, Dim>() += hess;
+    }
+    return energy;
+}
+} // namespace
+
+double TriangleAMIPS::evaluate(
+    const simplex::Simplex& domain_simplex,
+    const std::optional<simplex::Simplex>& variable_simplex,
+    Eigen::Matrix<double, 3, 1>* gradient,
+    Eigen::Matrix<double, 3, 3>* hessian) const
+{
+    assert(
+        domain_simplex.primitive_type() ==
+        PrimitiveType::Triangle); // "TriangleAMIPS only supports faces meshes"
+
+    auto [attrs, index] = utils::get_simplex_attributes(
+        mesh(),
+        coordinate_accessor(),
+        m_primitive_type,
+        domain_simplex,
+        variable_simplex.has_value() ? variable_simplex->tuple() : std::optional<Tuple>());
+    assert(attrs.size() == 3);
+
+    // a cyclic shift keeps the orientation, so the variable can always be p
+    const size_t i = index < 0 ? 0 : index;
+    const auto& p = attrs[i];
+    const auto& q = attrs[(i + 1) % 3];
+    const auto& r = attrs[(i + 2) % 3];
+
+    switch (embedded_dimension()) {
+    case 2:
+        return amips_closed_form<2>(p.head<2>(), q.head<2>(), r.head<2>(), gradient, hessian);
+    case 3:
+        return amips_closed_form<3>(p.head<3>(), q.head<3>(), r.head<3>(), gradient, hessian);
+    default: assert(false); // "TriangleAMIPS only supports 2D and 3D meshes"
+    }
+
+    return 0;
+}
+
+double TriangleAMIPS::get_value(const simplex::Simplex& domain_simplex) const
+{
+    return evaluate(domain_simplex, {}, nullptr, nullptr);
+}
+
+Eigen::VectorXd TriangleAMIPS::get_gradient(
+    const simplex::Simplex& domain_simplex,
+    const simplex::Simplex& variable_simplex) const
+{
+    Eigen::Vector3d res = Eigen::Vector3d::Zero();
+    evaluate(domain_simplex, variable_simplex, &res, nullptr);
+    return res.head(embedded_dimension());
+}
+
+Eigen::MatrixXd TriangleAMIPS::get_hessian(
+    const simplex::Simplex& domain_simplex,
+    const simplex::Simplex& variable_simplex) const
+{
+    Eigen::Matrix3d res = Eigen::Matrix3d::Zero();
+    evaluate(domain_simplex, variable_simplex, nullptr, &res);
+    const int64_t dim = embedded_dimension();
+    return res.topLeftCorner(dim, dim);
+}
+
+void TriangleAMIPS::add_gradient(
+    const simplex::Simplex& domain_simplex,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Matrix<double, 3, 1>& gradient) const
+{
+    evaluate(domain_simplex, variable_simplex, &gradient, nullptr);
+}
+
+void TriangleAMIPS::add_hessian(
+    const simplex::Simplex& domain_simplex,
+    const simplex::Simplex& variable_simplex,
+    Eigen::Matrix<double, 3, 3>& hessian) const
+{
+    evaluate(domain_simplex, variable_simplex, nullptr, &hessian);
+}
+
 using DScalar = typename PerSimplexAutodiffFunction::DScalar;
 using DSVec2 = Eigen::Vector2<DScalar>;
 using DSVec3 = Eigen::Vector3<DScalar>;
@@ -5,7 +5,8 @@
 namespace wmtk::function {
 /**
  * @brief This is the implementation of the AMIPS energy function of a triangle mesh that can be
- * embedded in 2d or 3d. It uses autodiff encoding for differentiations.
+ * embedded in 2d or 3d. The value and derivatives are evaluated in closed form, the autodiff
+ * encoding of PerSimplexAutodiffFunction is kept to validate them.
  *
  */
 class TriangleAMIPS : public PerSimplexAutodiffFunction
@@ -15,9 +16,36 @@ public:
 
     ~TriangleAMIPS();
 
+    double get_value(const simplex::Simplex& domain_simplex) const override;
+
+    Eigen::VectorXd get_gradient(
+        const simplex::Simplex& domain_simplex,
+        const simplex::Simplex& variable_simplex) const override;
+
+    Eigen::MatrixXd get_hessian(
+        const simplex::Simplex& domain_simplex,
+        const simplex::Simplex& variable_simplex) const override;
+
+    void add_gradient(
+        const simplex::Simplex& domain_simplex,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 1>& gradient) const override;
+
+    void add_hessian(
+        const simplex::Simplex& domain_simplex,
+        const simplex::Simplex& variable_simplex,
+        Eigen::Matrix<double, 3, 3>& hessian) const override;
+
 protected:
     DScalar eval(const simplex::Simplex& domain_simplex, const std::vector<DSVec>& coordinates)
         const override;
+
+private:
+    double evaluate(
+        const simplex::Simplex& domain_simplex,
+        const std::optional<simplex::Simplex>& variable_simplex,
+        Eigen::Matrix<double, 3, 1>* gradient,
+        Eigen::Matrix<double, 3, 3>* hessian) const;
 };
 
 } // namespace wmtk::function
@@ -0,0 +1,180 @@
+#include "amips_one_ring.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "amips.hpp"
+
+namespace wmtk::function::utils {
+
+void TetOneRing::clear(const Eigen::Vector3d& center)
+{
+    m_center = center;
+    m_size = 0;
+    for (std::vector<double>& c : m_coordinates) {
+        c.clear();
+    }
+}
+
+void TetOneRing::push_back(
+    const Eigen::Vector3d& q0,
+    const Eigen::Vector3d& q1,
+    const Eigen::Vector3d& q2)
+{
+    if (m_size % lanes == 0) {
+        // open a new lane group, padded with the corner of the unit cube at the center
+        for (int64_t j = 0; j < 3; ++j) {
+            for (int64_t axis = 0; axis < 3; ++axis) {
+                std::vector<double>& c = m_coordinates[3 * j + axis];
+                c.resize(c.size() + lanes, m_center[axis] + (j == axis ? 1 : 0));
+            }
+        }
+    }
+
+    const std::array<const Eigen::Vector3d*, 3> q = {{&q0, &q1, &q2}};
+    for (int64_t j = 0; j < 3; ++j) {
+        for (int64_t axis = 0; axis < 3; ++axis) {
+            m_coordinates[3 * j + axis][m_size] = (*q[j])[axis];
+        }
+    }
+    ++m_size;
+}
+
+namespace {
+constexpr int64_t L = TetOneRing::lanes;
+
+/*
+ * Around the center p, with a, b, c the edges to the other vertices, the energy of a tet is
+ *   E = k Q / cbrt(D^2),  Q = sum of the six squared edge lengths / 3,  D = a . (b x c)
+ * where k = cbrt(27 / 16) gives 3 for the regular tet. D is affine in p, hence
+ *   grad E = E g,  g = grad Q / Q - 2/3 grad D / D
+ *   hess E = E (g g^T + 2 I / Q - grad Q grad Q^T / Q^2 + 2/3 grad D grad D^T / D^2)
+ */
+template <bool Gradient, bool Hessian>
+double one_ring(const TetOneRing& ring, Eigen::Vector3d* gradient, Eigen::Matrix3d* hessian)
+{
+    static const double k = std::cbrt(27. / 16.);
+    const double px = ring.center().x();
+    const double py = ring.center().y();
+    const double pz = ring.center().z();
+
+    const double* q[9];
+    for (int64_t j = 0; j < 9; ++j) {
+        q[j] = ring.coordinates(j / 3, j % 3);
+    }
+
+    double energy = 0;
+    Eigen::Vector3d g_sum = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d h_sum = Eigen::Matrix3d::Zero();
+
+    for (int64_t start = 0; start < ring.size(); start += L) {
+        alignas(64) double e[L];
+        alignas(64) double g[3][L];
+        alignas(64) double h[6][L];
+
+        // the lanes are independent and branch free so that the compiler maps them to SIMD
+        // registers, or runs them one by one where the target has none
+        for (int64_t l = 0; l < L; ++l) {
+            const int64_t i = start + l;
+            const double ax = q[0][i] - px, ay = q[1][i] - py, az = q[2][i] - pz;
+            const double bx = q[3][i] - px, by = q[4][i] - py, bz = q[5][i] - pz;
+            const double cx = q[6][i] - px, cy = q[7][i] - py, cz = q[8][i] - pz;
+
+            const double bcx = by * cz - bz * cy, bcy = bz * cx - bx * cz, bcz = bx * cy - by * cx;
+            const double D = ax * bcx + ay * bcy + az * bcz;
+
+            const double aa = ax * ax + ay * ay + az * az;
+            const double bb = bx * bx + by * by + bz * bz;
+            const double cc = cx * cx + cy * cy + cz * cz;
+            const double ab = ax * bx + ay * by + az * bz;
+            const double bc = bx * cx + by * cy + bz * cz;
+            const double ca = cx * ax + cy * ay + cz * az;
+            const double Q = (aa + bb + cc) - 2. / 3. * (ab + bc + ca);
+
+            const double E = k * Q / std::cbrt(D * D);
+            e[l] = E;
+            if constexpr (Gradient || Hessian) {
+                const double cax = cy * az - cz * ay, cay = cz * ax - cx * az,
+                             caz = cx * ay - cy * ax;
+                const double abx = ay * bz - az * by, aby = az * bx - ax * bz,
+                             abz = ax * by - ay * bx;
+                const double dDx = -(bcx + cax + abx);
+                const double dDy = -(bcy + cay + aby);
+                const double dDz = -(bcz + caz + abz);
+                const double dQx = -2. / 3. * (ax + bx + cx);
+                const double dQy = -2. / 3. * (ay + by + cy);
+                const double dQz = -2. / 3. * (az + bz + cz);
+
+                const double iQ = 1 / Q, iD = 1 / D;
+                const double glx = dQx * iQ - 2. / 3. * dDx * iD;
+                const double gly = dQy * iQ - 2. / 3. * dDy * iD;
+                const double glz = dQz * iQ - 2. / 3. * dDz * iD;
+                if constexpr (Gradient) {
+                    g[0][l] = E * glx;
+                    g[1][l] = E * gly;
+                    g[2][l] = E * glz;
+                }
+                if constexpr (Hessian) {
+                    const double iQ2 = iQ * iQ, iD2 = 2. / 3. * iD * iD;
+                    const double d = 2 * iQ;
+                    h[0][l] = E * (glx * glx + d - dQx * dQx * iQ2 + dDx * dDx * iD2);
+                    h[1][l] = E * (glx * gly - dQx * dQy * iQ2 + dDx * dDy * iD2);
+                    h[2][l] = E * (glx * glz - dQx * dQz * iQ2 + dDx * dDz * iD2);
+                    h[3][l] = E * (gly * gly + d - dQy * dQy * iQ2 + dDy * dDy * iD2);
+                    h[4][l] = E * (gly * glz - dQy * dQz * iQ2 + dDy * dDz * iD2);
+                    h[5][l] = E * (glz * glz + d - dQz * dQz * iQ2 + dDz * dDz * iD2);
+                }
+            }
+        }
+
+        // reduce the valid lanes, the padding is skipped
+        const int64_t count = std::min(L, ring.size() - start);
+        for (int64_t l = 0; l < count; ++l) {
+            if (e[l] > 1e8) {
+                // as unstable as Tet_AMIPS_energy_aux, use its exact fallback for the value
+                const int64_t i = start + l;
+                energy += Tet_AMIPS_energy({{px, py, pz, q[0][i], q[1][i], q[2][i], q[3][i],
+                                             q[4][i], q[5][i], q[6][i], q[7][i], q[8][i]}});
+            } else {
+                energy += e[l];
+            }
+            if constexpr (Gradient) {
+                g_sum += Eigen::Vector3d(g[0][l], g[1][l], g[2][l]);
+            }
+            if constexpr (Hessian) {
+                h_sum(0, 0) += h[0][l];
+                h_sum(0, 1) += h[1][l];
+                h_sum(0, 2) += h[2][l];
+                h_sum(1, 1) += h[3][l];
+                h_sum(1, 2) += h[4][l];
+                h_sum(2, 2) += h[5][l];
+            }
+        }
+    }
+
+    if constexpr (Gradient) {
+        *gradient += g_sum;
+    }
+    if constexpr (Hessian) {
+        h_sum(1, 0) = h_sum(0, 1);
+        h_sum(2, 0) = h_sum(0, 2);
+        h_sum(2, 1) = h_sum(1, 2);
+        *hessian += h_sum;
+    }
+    return energy;
+}
+} // namespace
+
+double Tet_AMIPS_one_ring(const TetOneRing& ring, Eigen::Vector3d* gradient, Eigen::Matrix3d* hessian)
+{
+    if (gradient != nullptr && hessian != nullptr) {
+        return one_ring<true, true>(ring, gradient, hessian);
+    } else if (gradient != nullptr) {
+        return one_ring<true, false>(ring, gradient, hessian);
+    } else if (hessian != nullptr) {
+        return one_ring<false, true>(ring, gradient, hessian);
+    }
+    return one_ring<false, false>(ring, gradient, hessian);
+}
+
+} // namespace wmtk::function::utils
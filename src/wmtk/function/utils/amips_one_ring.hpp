@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Eigen/Core>
+#include <array>
+#include <vector>
+
+namespace wmtk::function::utils {
+
+/**
+ * @brief The tets around a vertex in structure of arrays layout, to evaluate the AMIPS energy of a
+ * whole one ring in lane groups.
+ *
+ * Each tet is stored by the positions of its three vertices other than the center. The arrays are
+ * padded to a multiple of TetOneRing::lanes with a non degenerate tet, masked out of the sums.
+ */
+class TetOneRing
+{
+public:
+    /// width of a lane group, 8 doubles fill one AVX-512 or two AVX2 registers
+    static constexpr int64_t lanes = 8;
+
+    /// removes all tets and sets the vertex they are around, keeps the storage
+    void clear(const Eigen::Vector3d& center);
+
+    /// adds the tet of the center and q0, q1, q2, in any order
+    void push_back(const Eigen::Vector3d& q0, const Eigen::Vector3d& q1, const Eigen::Vector3d& q2);
+
+    const Eigen::Vector3d& center() const { return m_center; }
+
+    /// number of tets
+    int64_t size() const { return m_size; }
+
+    /// the axis coordinate of the j-th non center vertex of every tet, padded
+    const double* coordinates(int64_t j, int64_t axis) const
+    {
+        return m_coordinates[3 * j + axis].data();
+    }
+
+private:
+    Eigen::Vector3d m_center = Eigen::Vector3d::Zero();
+    int64_t m_size = 0;
+    std::array<std::vector<double>, 9> m_coordinates;
+};
+
+/**
+ * @brief Sum of the AMIPS energies of the tets of ring, as Tet_AMIPS_energy would give one tet at a
+ * time. The derivatives wrt the center are added to the non null outputs.
+ */
+double Tet_AMIPS_one_ring(
+    const TetOneRing& ring,
+    Eigen::Vector3d* gradient = nullptr,
+    Eigen::Matrix3d* hessian = nullptr);
+
+} // namespace wmtk::function::utils
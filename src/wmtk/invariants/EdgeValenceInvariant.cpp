@@ -14,6 +14,8 @@ bool EdgeValenceInvariant::before(const simplex::Simplex& simplex) const
 
     assert(simplex.primitive_type() == PrimitiveType::Edge);
 
-    return simplex::top_dimension_cofaces_tuples(mesh(), simplex).size() == m_valence;
+    simplex::TopDimensionCofacesBuffer cofaces;
+    simplex::top_dimension_cofaces_tuples(mesh(), simplex, cofaces);
+    return cofaces.size() == m_valence;
 }
 } // namespace wmtk::invariants
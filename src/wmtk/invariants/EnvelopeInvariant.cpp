@@ -1,8 +1,8 @@
 #include "EnvelopeInvariant.hpp"
 
 #include <wmtk/Mesh.hpp>
+#include <wmtk/envelope/EnvelopeIndex.hpp>
 #include <wmtk/simplex/SimplexCollection.hpp>
-#include <wmtk/simplex/faces_single_dimension.hpp>
 #include <wmtk/simplex/utils/tuple_vector_to_homogeneous_simplex_vector.hpp>
 #include <wmtk/utils/Logger.hpp>
 
@@ -22,64 +22,28 @@ EnvelopeInvariant::EnvelopeInvariant(
     const attribute::MeshAttributeHandle& envelope_mesh_coordinate,
     double envelope_size,
     const attribute::MeshAttributeHandle& coordinate)
+    : EnvelopeInvariant(
+          std::make_shared<envelope::EnvelopeIndex>(envelope_mesh_coordinate),
+          envelope_size,
+          coordinate)
+{}
+
+EnvelopeInvariant::EnvelopeInvariant(
+    const std::shared_ptr<envelope::EnvelopeIndex>& envelope,
+    double envelope_size,
+    const attribute::MeshAttributeHandle& coordinate)
     : Invariant(coordinate.mesh())
+    , m_envelope_index(envelope)
     , m_coordinate_handle(coordinate.as<double>())
+    , m_coordinate_accessor(mesh().create_const_accessor(m_coordinate_handle))
     , m_envelope_size(envelope_size)
 {
-    const auto& envelope_mesh = envelope_mesh_coordinate.mesh();
-    const attribute::Accessor<double> accessor =
-        envelope_mesh.create_const_accessor(envelope_mesh_coordinate.as<double>());
-
-
-    if (envelope_mesh.top_simplex_type() == PrimitiveType::Triangle) {
-        std::vector<Eigen::Vector3d> vertices;
-        std::vector<Eigen::Vector3i> faces;
-
-        int count = 0;
-        assert(accessor.dimension() == 3);
-
-        const std::vector<Tuple>& facest = envelope_mesh.get_all(wmtk::PrimitiveType::Triangle);
-        for (const auto& f : facest) {
-            Eigen::Vector3d p0 = accessor.const_vector_attribute(f);
-            Eigen::Vector3d p1 = accessor.const_vector_attribute(envelope_mesh.switch_tuple(f, PV));
-            Eigen::Vector3d p2 =
-                accessor.const_vector_attribute(envelope_mesh.switch_tuples(f, {PE, PV}));
-
-            faces.emplace_back(count, count + 1, count + 2);
-            vertices.push_back(p0);
-            vertices.push_back(p1);
-            vertices.push_back(p2);
-
-            count += 3;
-        }
-
-        m_envelope = std::make_shared<fastEnvelope::FastEnvelope>(vertices, faces, envelope_size);
-
-    } else if (envelope_mesh.top_simplex_type() == PrimitiveType::Edge) {
+    if (envelope->facet_type() == PrimitiveType::Triangle) {
+        assert(envelope->vertices().cols() == 3);
+        m_envelope = envelope->fast_envelope(envelope_size);
+    } else if (envelope->facet_type() == PrimitiveType::Edge) {
         logger().warn("Envelope for edge mesh is using sampling");
-
-        int64_t count = 0;
-        int64_t index = 0;
-
-        const std::vector<Tuple>& edgest = envelope_mesh.get_all(wmtk::PrimitiveType::Edge);
-
-        Eigen::MatrixXd vertices(2 * edgest.size(), accessor.dimension());
-        Eigen::MatrixXi edges(edgest.size(), 2);
-
-        for (const auto& e : edgest) {
-            auto p0 = accessor.const_vector_attribute(e);
-            auto p1 = accessor.const_vector_attribute(envelope_mesh.switch_tuple(e, PV));
-
-            edges.row(index) << count, count + 1;
-            vertices.row(2 * index) = p0;
-            vertices.row(2 * index + 1) = p1;
-
-            count += 2;
-            ++index;
-        }
-
-        m_bvh = std::make_shared<SimpleBVH::BVH>();
-        m_bvh->init(vertices, edges, 1e-10);
+        m_bvh = envelope->bvh();
     } else {
         throw std::runtime_error("Envelope works only for tri/edges meshes");
     }
@@ -91,26 +55,22 @@ bool EnvelopeInvariant::after(
 {
     if (top_dimension_tuples_after.empty()) return true;
 
-    const attribute::Accessor<double> accessor = mesh().create_const_accessor(m_coordinate_handle);
+    const attribute::Accessor<double>& accessor = m_coordinate_accessor;
     const auto type = mesh().top_simplex_type();
 
     if (m_envelope) {
         assert(accessor.dimension() == 3);
 
-        std::vector<Tuple> faces;
-
+        // switch_tuple visits the vertices without allocating, the loops exit at the first
+        // simplex outside of the envelope
         if (type == PrimitiveType::Triangle) {
             std::array<Eigen::Vector3d, 3> triangle;
 
             for (const Tuple& tuple : top_dimension_tuples_after) {
-                faces = faces_single_dimension_tuples(
-                    mesh(),
-                    simplex::Simplex(type, tuple),
-                    PrimitiveType::Vertex);
-
-                triangle[0] = accessor.const_vector_attribute(faces[0]);
-                triangle[1] = accessor.const_vector_attribute(faces[1]);
-                triangle[2] = accessor.const_vector_attribute(faces[2]);
+                triangle[0] = accessor.const_vector_attribute(tuple);
+                triangle[1] = accessor.const_vector_attribute(mesh().switch_tuple(tuple, PV));
+                triangle[2] =
+                    accessor.const_vector_attribute(mesh().switch_tuples(tuple, {PE, PV}));
 
                 if (m_envelope->is_outside(triangle)) return false;
             }
@@ -118,13 +78,9 @@ bool EnvelopeInvariant::after(
             return true;
         } else if (type == PrimitiveType::Edge) {
             for (const Tuple& tuple : top_dimension_tuples_after) {
-                faces = faces_single_dimension_tuples(
-                    mesh(),
-                    simplex::Simplex(type, tuple),
-                    PrimitiveType::Vertex);
-
-                Eigen::Vector3d p0 = accessor.const_vector_attribute(faces[0]);
-                Eigen::Vector3d p1 = accessor.const_vector_attribute(faces[1]);
+                const Eigen::Vector3d p0 = accessor.const_vector_attribute(tuple);
+                const Eigen::Vector3d p1 =
+                    accessor.const_vector_attribute(mesh().switch_tuple(tuple, PV));
 
                 if (m_envelope->is_outside(p0, p1)) return false;
             }
@@ -132,7 +88,7 @@ bool EnvelopeInvariant::after(
             return true;
         } else if (type == PrimitiveType::Vertex) {
             for (const Tuple& tuple : top_dimension_tuples_after) {
-                Eigen::Vector3d p = accessor.const_vector_attribute(tuple);
+                const Eigen::Vector3d p = accessor.const_vector_attribute(tuple);
 
                 if (m_envelope->is_outside(p)) return false;
             }
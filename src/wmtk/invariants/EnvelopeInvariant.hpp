@@ -5,6 +5,7 @@
 #include <Eigen/Dense>
 
 #include <memory>
+#include <wmtk/attribute/Accessor.hpp>
 #include <wmtk/attribute/MeshAttributeHandle.hpp>
 
 namespace fastEnvelope {
@@ -13,6 +14,9 @@ class FastEnvelope;
 namespace SimpleBVH {
 class BVH;
 }
+namespace wmtk::envelope {
+class EnvelopeIndex;
+}
 
 namespace wmtk::invariants {
 class EnvelopeInvariant : public Invariant
@@ -22,15 +26,24 @@ public:
         const attribute::MeshAttributeHandle& envelope_mesh_coordinate,
         double envelope_size,
         const attribute::MeshAttributeHandle& coordinate);
+    /**
+     * @brief Uses the geometry of an envelope shared with other invariants and operations.
+     */
+    EnvelopeInvariant(
+        const std::shared_ptr<envelope::EnvelopeIndex>& envelope,
+        double envelope_size,
+        const attribute::MeshAttributeHandle& coordinate);
 
     bool after(
         const std::vector<Tuple>& top_dimension_tuples_before,
         const std::vector<Tuple>& top_dimension_tuples_after) const override;
 
 private:
+    std::shared_ptr<envelope::EnvelopeIndex> m_envelope_index;
     std::shared_ptr<fastEnvelope::FastEnvelope> m_envelope = nullptr;
     std::shared_ptr<SimpleBVH::BVH> m_bvh = nullptr;
     const TypedAttributeHandle<double> m_coordinate_handle;
+    const attribute::Accessor<double> m_coordinate_accessor;
     const double m_envelope_size;
 };
 } // namespace wmtk::invariants
@@ -1,8 +1,8 @@
 #include "SimplexInversionInvariant.hpp"
 #include <wmtk/Mesh.hpp>
 #include <wmtk/simplex/faces_single_dimension.hpp>
+#include <wmtk/utils/orient.hpp>
 #include <wmtk/utils/triangle_areas.hpp>
-#include "predicates.h"
 #include <wmtk/EdgeMesh.hpp>
 #include <wmtk/TriMesh.hpp>
 #include <wmtk/TetMesh.hpp>
@@ -13,6 +13,7 @@ SimplexInversionInvariant::SimplexInversionInvariant(
     const TypedAttributeHandle<double>& coordinate)
     : Invariant(m, true, false, true)
     , m_coordinate_handle(coordinate)
+    , m_coordinate_accessor(m.create_const_accessor(coordinate))
 {}
 
 bool SimplexInversionInvariant::after(
@@ -20,24 +21,22 @@ bool SimplexInversionInvariant::after(
     const std::vector<Tuple>& top_dimension_tuples_after) const
 {
 
+    // the vertices are read from the connectivity in their local order, which is positively
+    // oriented for valid simplices, no matter the orientation of the tuple
     if (mesh().top_simplex_type() == PrimitiveType::Tetrahedron) {
         const TetMesh& mymesh = static_cast<const TetMesh&>(mesh());
-        auto accessor = mymesh.create_const_accessor(m_coordinate_handle);
-        assert(accessor.dimension() == 3);
+        const attribute::CachingAccessor<double>& accessor = m_coordinate_accessor.index_access();
+        assert(m_coordinate_accessor.dimension() == 3);
 
         for (const auto& t : top_dimension_tuples_after) {
-            Eigen::Vector3d p0 = accessor.const_vector_attribute<3>(t);
-            Eigen::Vector3d p1 = accessor.const_vector_attribute<3>(mymesh.switch_tuple(t, PrimitiveType::Vertex));
-            Eigen::Vector3d p2 =
-                accessor.const_vector_attribute<3>(mymesh.switch_tuples(t, {PrimitiveType::Edge, PrimitiveType::Vertex}));
-            Eigen::Vector3d p3 = accessor.const_vector_attribute<3>(
-                mymesh.switch_tuples(t,{PrimitiveType::Triangle, PrimitiveType::Edge, PrimitiveType::Vertex}));
-
-            if (mymesh.is_ccw(t)) {
-                if (orient3d(p3.data(), p0.data(), p1.data(), p2.data()) <= 0) return false;
-
-            } else {
-                if (orient3d(p3.data(), p0.data(), p2.data(), p1.data()) <= 0) return false;
+            const auto tv = mymesh.m_tv_accessor->const_vector_attribute<4>(t);
+            const auto p0 = accessor.const_vector_attribute<3>(tv[0]);
+            const auto p1 = accessor.const_vector_attribute<3>(tv[1]);
+            const auto p2 = accessor.const_vector_attribute<3>(tv[2]);
+            const auto p3 = accessor.const_vector_attribute<3>(tv[3]);
+
+            if (utils::orient3d_sign(p0.data(), p1.data(), p2.data(), p3.data()) <= 0) {
+                return false;
             }
         }
 
@@ -46,27 +45,23 @@ bool SimplexInversionInvariant::after(
 
     } else if (mesh().top_simplex_type() == PrimitiveType::Triangle) {
         const TriMesh& mymesh = static_cast<const TriMesh&>(mesh());
-        auto accessor = mymesh.create_const_accessor(m_coordinate_handle);
-        assert(accessor.dimension() == 2);
+        const attribute::CachingAccessor<double>& accessor = m_coordinate_accessor.index_access();
+        assert(m_coordinate_accessor.dimension() == 2);
 
         for (const Tuple& tuple : top_dimension_tuples_after) {
-            Tuple ccw_tuple = tuple;
-            if (!mymesh.is_ccw(tuple)) {
-                ccw_tuple = mymesh.switch_tuple(tuple,PrimitiveType::Vertex);
-            }
-            Eigen::Vector2d p0 = accessor.const_vector_attribute<2>(ccw_tuple);
-            Eigen::Vector2d p1 = accessor.const_vector_attribute<2>(mymesh.switch_tuple(ccw_tuple, PrimitiveType::Vertex));
-            Eigen::Vector2d p2 = accessor.const_vector_attribute<2>(
-                    mymesh.switch_tuples(ccw_tuple, {PrimitiveType::Edge,  PrimitiveType::Vertex}));
+            const auto fv = mymesh.m_fv_accessor->const_vector_attribute<3>(tuple);
+            const auto p0 = accessor.const_vector_attribute<2>(fv[0]);
+            const auto p1 = accessor.const_vector_attribute<2>(fv[1]);
+            const auto p2 = accessor.const_vector_attribute<2>(fv[2]);
 
-            if (orient2d(p0.data(), p1.data(), p2.data()) <= 0) return false;
+            if (utils::orient2d_sign(p0.data(), p1.data(), p2.data()) <= 0) return false;
         }
 
 
         return true;
     } else if (mesh().top_simplex_type() == PrimitiveType::Edge) {
         const EdgeMesh& mymesh = static_cast<const EdgeMesh&>(mesh());
-        auto accessor = mymesh.create_const_accessor(m_coordinate_handle);
+        const attribute::Accessor<double>& accessor = m_coordinate_accessor;
         assert(accessor.dimension() == 1);
 
         for (const Tuple& tuple : top_dimension_tuples_after) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <wmtk/attribute/Accessor.hpp>
 #include <wmtk/attribute/TypedAttributeHandle.hpp>
 #include "Invariant.hpp"
 
@@ -19,5 +20,6 @@ public:
 
 private:
     const TypedAttributeHandle<double> m_coordinate_handle;
+    const attribute::Accessor<double> m_coordinate_accessor;
 };
 } // namespace wmtk
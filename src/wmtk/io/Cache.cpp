@@ -33,6 +33,7 @@ Cache::Cache(Cache&& o)
     , m_file_paths(std::move(o.m_file_paths))
     , m_multimeshes(std::move(o.m_multimeshes))
     , m_delete_cache(o.m_delete_cache)
+    , m_hdf5_writer_options(o.m_hdf5_writer_options)
 {
     // make sure that the other cache doesn't use delete semantics anymore
     o.m_delete_cache = false;
@@ -43,6 +44,7 @@ Cache& Cache::operator=(Cache&& o)
     m_file_paths = std::move(o.m_file_paths);
     m_multimeshes = std::move(o.m_multimeshes);
     m_delete_cache = o.m_delete_cache;
+    m_hdf5_writer_options = o.m_hdf5_writer_options;
     // make sure that the other cache doesn't use delete semantics anymore
     o.m_delete_cache = false;
     return *this;
@@ -214,10 +216,15 @@ void Cache::write_mesh(
                 const_cast<Mesh&>(m).get_multi_mesh_root().shared_from_this()));
     }
 
-    HDF5Writer writer(p);
+    HDF5Writer writer(p, m_hdf5_writer_options);
     m.serialize(writer, &m);
 }
 
+void Cache::set_hdf5_writer_options(const HDF5WriterOptions& options)
+{
+    m_hdf5_writer_options = options;
+}
+
 bool Cache::export_cache(const std::filesystem::path& export_location)
 {
     if (fs::exists(export_location)) {
@@ -249,6 +256,27 @@ bool Cache::export_cache(const std::filesystem::path& export_location)
     return true;
 }
 
+bool Cache::export_cache(
+    const std::filesystem::path& export_location,
+    const HDF5WriterOptions& options)
+{
+    if (!export_cache(export_location)) {
+        return false;
+    }
+
+    for (const auto& [name, path] : m_file_paths) {
+        if (path.extension() != ".hdf5") {
+            continue;
+        }
+        const fs::path exported_path = export_location / fs::relative(path, m_cache_dir);
+        const std::shared_ptr<Mesh> mesh = wmtk::read_mesh(path);
+        HDF5Writer writer(exported_path, options);
+        mesh->serialize(writer);
+    }
+
+    return true;
+}
+
 bool Cache::import_cache(const std::filesystem::path& import_location)
 {
     if (!fs::exists(import_location)) {
@@ -5,6 +5,7 @@
 #include <string_view>
 #include <wmtk/Mesh.hpp>
 #include "CachedMultiMesh.hpp"
+#include "HDF5Writer.hpp"
 
 namespace wmtk::io {
 
@@ -96,6 +97,11 @@ public:
         const std::string& name,
         const std::map<std::string, std::vector<int64_t>>& multimesh_names = {});
 
+    /**
+     * @brief Set the dataset options used by write_mesh for all following writes.
+     */
+    void set_hdf5_writer_options(const HDF5WriterOptions& options);
+
     /**
      * @brief Export the cache to the given location.
      *
@@ -107,6 +113,18 @@ public:
      */
     bool export_cache(const std::filesystem::path& export_location);
 
+    /**
+     * @brief Export the cache to the given location and rewrite all meshes with the given options.
+     *
+     * Same as `export_cache(export_location)` but the exported meshes are written again with the
+     * given dataset options, e.g. to compress them. The cache itself is not modified.
+     *
+     * returns true if export was successful, false otherwise
+     */
+    bool export_cache(
+        const std::filesystem::path& export_location,
+        const HDF5WriterOptions& options);
+
     /**
      * @brief Import a cache from the given location.
      *
@@ -152,6 +170,7 @@ private:
     std::map<std::string, std::filesystem::path> m_file_paths; // name --> file location
     mutable std::map<std::string, CachedMultiMesh> m_multimeshes;
     bool m_delete_cache = true;
+    HDF5WriterOptions m_hdf5_writer_options;
 
     inline static const std::string m_cache_content_name =
         "cache_contents"; // name of the json file used for import/export
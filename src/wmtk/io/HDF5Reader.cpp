@@ -150,7 +150,16 @@ std::shared_ptr<Mesh> HDF5Reader::read_mesh(h5pp::File& hdf5_file, const std::st
             const auto default_val = hdf5_file.readAttribute<int64_t>(dataset, "default_value");
 
             set_attribute<int64_t>(default_val, name, pt, stride, v, *mesh);
+        } else if (type == "char8") {
+            auto tmp = hdf5_file.readDataset<std::vector<int8_t>>(dataset);
+            const auto default_val =
+                char(hdf5_file.readAttribute<int8_t>(dataset, "default_value"));
+
+            std::vector<char> v(tmp.begin(), tmp.end());
+
+            set_attribute<char>(default_val, name, pt, stride, v, *mesh);
         } else if (type == "char") {
+            // layout written before char attributes were stored as 8 bit integers
             auto tmp = hdf5_file.readDataset<std::vector<short>>(dataset);
             const auto default_val = char(hdf5_file.readAttribute<short>(dataset, "default_value"));
 
@@ -167,6 +176,7 @@ std::shared_ptr<Mesh> HDF5Reader::read_mesh(h5pp::File& hdf5_file, const std::st
 
             set_attribute<double>(default_val, name, pt, stride, v, *mesh);
         } else if (type == "rational") {
+            // layout written before the binary encoding: numerator and denominator as strings
             auto tmp = hdf5_file.readDataset<std::vector<std::string>>(dataset);
             assert(tmp.size() % 2 == 0);
             std::string numer = hdf5_file.readAttribute<std::string>(dataset, "default_value");
@@ -180,6 +190,24 @@ std::shared_ptr<Mesh> HDF5Reader::read_mesh(h5pp::File& hdf5_file, const std::st
 
             set_attribute<Rational>(default_val, name, pt, stride, v, *mesh);
 
+        } else if (type == "rational_binary") {
+            const auto tmp = hdf5_file.readDataset<std::vector<uint8_t>>(dataset);
+            const auto default_tmp =
+                hdf5_file.readAttribute<std::vector<uint8_t>>(dataset, "default_value");
+            const int64_t size = hdf5_file.readAttribute<int64_t>(dataset, "size");
+
+            Rational default_val;
+            default_val.read_binary(default_tmp.data(), default_tmp.data() + default_tmp.size());
+
+            std::vector<Rational> v(size);
+            const uint8_t* data = tmp.data();
+            const uint8_t* end = tmp.data() + tmp.size();
+            for (Rational& r : v) {
+                data = r.read_binary(data, end);
+            }
+            assert(data == end);
+
+            set_attribute<Rational>(default_val, name, pt, stride, v, *mesh);
         } else {
             logger().error("We currently do not support reading the type \"{}\"", type);
             assert(false);
@@ -8,10 +8,13 @@
 #endif
 #include "HDF5Writer.hpp"
 
+#include <wmtk/utils/Logger.hpp>
 #include <wmtk/utils/Rational.hpp>
 
 #include <h5pp/h5pp.h>
 
+#include <algorithm>
+#include <optional>
 #include <sstream>
 
 namespace wmtk {
@@ -35,20 +38,28 @@ std::string get_type<double>()
 }
 
 template <>
-std::string get_type<short>()
+std::string get_type<int8_t>()
 {
-    return "char";
+    return "char8";
 }
 
-template <>
-std::string get_type<std::string>()
-{
-    return "rational";
-}
 } // namespace
 
-HDF5Writer::HDF5Writer(const std::filesystem::path& filename)
+HDF5Writer::HDF5Writer(const std::filesystem::path& filename, const HDF5WriterOptions& options)
+    : m_options(options)
 {
+    if (m_options.compression_level < 0 || m_options.compression_level > 9) {
+        log_and_throw_error(
+            "HDF5 compression level must be between 0 and 9, got {}",
+            m_options.compression_level);
+    }
+    if (m_options.chunk_size < 0) {
+        log_and_throw_error("HDF5 chunk size must not be negative, got {}", m_options.chunk_size);
+    }
+    if (m_options.compression_level > 0 && m_options.chunk_size == 0) {
+        m_options.chunk_size = HDF5WriterOptions::default_chunk_size;
+    }
+
     m_hdf5_file = std::make_shared<h5pp::File>(filename, h5pp::FileAccess::REPLACE);
 }
 
@@ -79,11 +90,10 @@ void HDF5Writer::write(
     const std::vector<char>& val,
     const char default_val)
 {
-    std::vector<short> tmp;
-    tmp.reserve(val.size());
-    for (const auto& v : val) tmp.push_back(v);
+    // stored as 8 bit integers, h5pp would treat a vector of chars as text
+    std::vector<int8_t> tmp(val.begin(), val.end());
 
-    write_internal(name, type, stride, tmp, short(default_val));
+    write_internal(name, type, stride, tmp, int8_t(default_val));
 }
 
 
@@ -94,15 +104,24 @@ void HDF5Writer::write(
     const std::vector<Rational>& val,
     const Rational& default_val)
 {
-    std::vector<std::string> tmp;
-    tmp.reserve(val.size() * 2);
+    // all values are packed into a single byte dataset, see Rational::write_binary
+    std::vector<uint8_t> tmp;
+    tmp.reserve(val.size() * 9);
     for (const auto& v : val) {
-        tmp.emplace_back(v.numerator());
-        tmp.emplace_back(v.denominator());
+        v.write_binary(tmp);
     }
+    std::vector<uint8_t> default_tmp;
+    default_val.write_binary(default_tmp);
+
     std::stringstream ss;
-    ss << default_val;
-    write_internal(name, type, stride, tmp, ss.str());
+    ss << dataset_path() << "/" << type << "/" << name;
+
+    write_dataset(tmp, ss.str());
+    m_hdf5_file->writeAttribute(stride, ss.str(), "stride");
+    m_hdf5_file->writeAttribute(default_tmp, ss.str(), "default_value");
+    m_hdf5_file->writeAttribute(type, ss.str(), "dimension");
+    m_hdf5_file->writeAttribute(int64_t(val.size()), ss.str(), "size");
+    m_hdf5_file->writeAttribute(std::string("rational_binary"), ss.str(), "type");
 }
 
 void HDF5Writer::write_capacities(const std::vector<int64_t>& capacities)
@@ -121,13 +140,37 @@ void HDF5Writer::write_internal(
     std::stringstream ss;
     ss << dataset_path() << "/" << type << "/" << name;
 
-    m_hdf5_file->writeDataset(val, ss.str());
+    write_dataset(val, ss.str());
     m_hdf5_file->writeAttribute(stride, ss.str(), "stride");
     m_hdf5_file->writeAttribute(default_val, ss.str(), "default_value");
     m_hdf5_file->writeAttribute(type, ss.str(), "dimension");
     m_hdf5_file->writeAttribute(get_type<T>(), ss.str(), "type");
 }
 
+template <typename T>
+void HDF5Writer::write_dataset(const std::vector<T>& val, const std::string& path)
+{
+    // HDF5 does not allow chunks of empty datasets
+    if (m_options.chunk_size == 0 || val.empty()) {
+        m_hdf5_file->writeDataset(val, path);
+        return;
+    }
+
+    const hsize_t chunk_size = std::min<hsize_t>(m_options.chunk_size, val.size());
+    std::optional<int> compression;
+    if (m_options.compression_level > 0) {
+        compression = m_options.compression_level;
+    }
+    m_hdf5_file->writeDataset(
+        val,
+        path,
+        H5D_CHUNKED,
+        std::nullopt,
+        std::vector<hsize_t>{chunk_size},
+        std::nullopt,
+        compression);
+}
+
 void HDF5Writer::write_top_simplex_type(const PrimitiveType type)
 {
     m_hdf5_file->writeAttribute(type, dataset_path(), "top_simplex_type");
@@ -9,10 +9,29 @@ class File;
 }
 
 namespace wmtk {
+
+/**
+ * @brief Storage options of the attribute datasets written by HDF5Writer.
+ *
+ * By default every attribute is written as one contiguous uncompressed dataset. Setting a chunk
+ * size or a compression level writes chunked datasets instead, compressed with the deflate filter
+ * if compression_level > 0.
+ */
+struct HDF5WriterOptions
+{
+    /// chunk size used for compressed datasets if chunk_size is 0
+    static constexpr int64_t default_chunk_size = 1 << 16;
+
+    /// number of values per chunk, 0 for contiguous datasets (or the default size if compressed)
+    int64_t chunk_size = 0;
+    /// deflate level between 0 (no compression) and 9
+    int compression_level = 0;
+};
+
 class HDF5Writer : public MeshWriter
 {
 public:
-    HDF5Writer(const std::filesystem::path& filename);
+    HDF5Writer(const std::filesystem::path& filename, const HDF5WriterOptions& options = {});
 
     void write_top_simplex_type(const PrimitiveType type) override;
     void write_absolute_id(const std::vector<int64_t>& id) override;
@@ -52,9 +71,13 @@ public:
 private:
     std::shared_ptr<h5pp::File> m_hdf5_file;
     std::string m_name;
+    HDF5WriterOptions m_options;
 
     std::string dataset_path() const;
 
+    template <typename T>
+    void write_dataset(const std::vector<T>& val, const std::string& path);
+
     template <typename T>
     void write_internal(
         const std::string& name,
@@ -73,7 +73,8 @@ ParaviewWriter::ParaviewWriter(
     bool write_points,
     bool write_edges,
     bool write_faces,
-    bool write_tetrahedra)
+    bool write_tetrahedra,
+    bool consolidated)
     : m_vertices_name(vertices_name)
 {
     m_enabled[0] = write_points;
@@ -83,11 +84,22 @@ ParaviewWriter::ParaviewWriter(
 
     std::array<Eigen::MatrixXi, 4> cells;
 
+    // vertex ids as they are written by Mesh::serialize_consolidated
+    std::vector<int64_t> vertex_old2new;
+    if (consolidated) {
+        vertex_old2new = std::move(std::get<1>(mesh.consolidation_maps())[0]);
+    }
+    auto vertex_id = [&](const Tuple& t) -> int64_t {
+        const int64_t vid = mesh.id(t, PrimitiveType::Vertex);
+        return consolidated ? vertex_old2new[vid] : vid;
+    };
+
     for (size_t i = 0; i < 4; ++i) {
         const auto pt = PrimitiveType(i);
         if (m_enabled[i]) {
-            // include deleted tuples so that attributes are aligned
-            const auto tuples = mesh.get_all(pt, true);
+            // include deleted tuples so that attributes are aligned, consolidated attributes only
+            // contain the live simplices
+            const auto tuples = mesh.get_all(pt, !consolidated);
             cells[i].resize(tuples.size(), i + 1);
 
             for (size_t j = 0; j < tuples.size(); ++j) {
@@ -97,25 +109,24 @@ ParaviewWriter::ParaviewWriter(
                         cells[i](j, d) = 0;
                     }
                 } else {
-                    int64_t vid = mesh.id(t, PrimitiveType::Vertex);
-                    cells[i](j, 0) = vid;
+                    cells[i](j, 0) = vertex_id(t);
                     if (i > 0) {
                         auto t1 = mesh.switch_tuple(t, PrimitiveType::Vertex);
 
-                        cells[i](j, 1) = mesh.id(t1, PrimitiveType::Vertex);
+                        cells[i](j, 1) = vertex_id(t1);
                     }
                     if (i > 1) {
                         auto t1 = mesh.switch_tuple(t, PrimitiveType::Edge);
                         auto t2 = mesh.switch_tuple(t1, PrimitiveType::Vertex);
 
-                        cells[i](j, 2) = mesh.id(t2, PrimitiveType::Vertex);
+                        cells[i](j, 2) = vertex_id(t2);
                     }
                     if (i > 2) {
                         auto t1 = mesh.switch_tuple(t, PrimitiveType::Triangle);
                         auto t2 = mesh.switch_tuple(t1, PrimitiveType::Edge);
                         auto t3 = mesh.switch_tuple(t2, PrimitiveType::Vertex);
 
-                        cells[i](j, 3) = mesh.id(t3, PrimitiveType::Vertex);
+                        cells[i](j, 3) = vertex_id(t3);
                     }
                 }
             }
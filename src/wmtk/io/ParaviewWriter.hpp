@@ -47,6 +47,10 @@ private:
     };
 
 public:
+    /**
+     * @param consolidated set if the mesh is written with Mesh::serialize_consolidated. The cells
+     * then only contain the simplices that are not deleted, indexed as after consolidate.
+     */
     ParaviewWriter(
         const std::filesystem::path& filename,
         const std::string& vertices_name,
@@ -54,7 +58,8 @@ public:
         bool write_points = true,
         bool write_edges = true,
         bool write_faces = true,
-        bool write_tetrahedra = true);
+        bool write_tetrahedra = true,
+        bool consolidated = false);
 
     bool write(const int dim) override { return dim == 0 || m_enabled[dim]; }
 
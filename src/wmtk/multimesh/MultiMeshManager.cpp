@@ -2,6 +2,7 @@
 #include <cassert>
 #include <wmtk/utils/vector_hash.hpp>
 //#include <fmt/ranges.h>
+#include <algorithm>
 #include <functional>
 #include <wmtk/Mesh.hpp>
 #include <wmtk/attribute/internal/hash.hpp>
@@ -301,7 +302,7 @@ const Mesh& MultiMeshManager::get_child_mesh(
 
     const Mesh* cur_mesh = &my_mesh;
 
-    for (auto it = relative_id.cbegin(); it != relative_id.cend(); ++it) {
+    for (auto it = relative_id.begin(); it != relative_id.end(); ++it) {
         // get the select ID from the child map
         int64_t child_index = *it;
         const ChildData& cd = cur_mesh->m_multi_mesh_manager.m_children.at(child_index);
@@ -387,7 +388,7 @@ std::pair<const Mesh&, Tuple> MultiMeshManager::map_up_to_tuples(
 std::vector<Tuple> MultiMeshManager::map_down_relative_tuples(
     const Mesh& my_mesh,
     const simplex::Simplex& my_simplex,
-    const std::vector<int64_t>& relative_id) const
+    const IdPath& relative_id) const
 {
     assert((&my_mesh.m_multi_mesh_manager) == this);
 
@@ -397,7 +398,7 @@ std::vector<Tuple> MultiMeshManager::map_down_relative_tuples(
     tuples.emplace_back(my_simplex.tuple());
     const Mesh* cur_mesh = &my_mesh;
 
-    for (auto it = relative_id.cbegin(); it != relative_id.cend(); ++it) {
+    for (auto it = relative_id.begin(); it != relative_id.end(); ++it) {
         // get the select ID from the child map
         int64_t child_index = *it;
         const ChildData& cd = cur_mesh->m_multi_mesh_manager.m_children.at(child_index);
@@ -431,14 +432,26 @@ std::vector<Tuple> MultiMeshManager::map_tuples(
     const Mesh& other_mesh,
     const simplex::Simplex& my_simplex) const
 {
-    const auto my_id = absolute_id();
-    const auto other_id = other_mesh.absolute_multi_mesh_id();
+    assert((&my_mesh.m_multi_mesh_manager) == this);
+    const MultiMeshManager& other_manager = other_mesh.m_multi_mesh_manager;
 
-    int64_t depth = my_id.size();
+    // the route always passes through the root, so only the meshes next to it get a shortcut
+    if (is_root()) {
+        if (&other_mesh == &my_mesh) {
+            return {my_simplex.tuple()};
+        }
+        if (other_manager.m_parent == &my_mesh) {
+            return map_to_child_tuples(my_mesh, m_children[other_manager.m_child_id], my_simplex);
+        }
+    } else if (m_parent == &other_mesh && other_manager.is_root()) {
+        return {map_tuple_to_parent_tuple(my_mesh, my_simplex.tuple())};
+    }
 
-    auto [root_ref, tuple] = map_up_to_tuples(my_mesh, my_simplex, depth);
+    auto [root_ref, tuple] = map_up_to_tuples(my_mesh, my_simplex, depth());
     const simplex::Simplex simplex(my_simplex.primitive_type(), tuple);
 
+    IdPath other_id;
+    relative_id_path(other_mesh, root_ref, other_id);
     return root_ref.m_multi_mesh_manager.map_down_relative_tuples(root_ref, simplex, other_id);
 }
 
@@ -447,18 +460,29 @@ std::vector<Tuple> MultiMeshManager::lub_map_tuples(
     const Mesh& other_mesh,
     const simplex::Simplex& my_simplex) const
 {
-    const auto my_id = absolute_id();
-    const auto other_id = other_mesh.absolute_multi_mesh_id();
-    const auto lub_id = least_upper_bound_id(my_id, other_id);
+    assert((&my_mesh.m_multi_mesh_manager) == this);
+    const MultiMeshManager& other_manager = other_mesh.m_multi_mesh_manager;
 
-    int64_t depth = my_id.size() - lub_id.size();
+    if (&other_mesh == &my_mesh) {
+        return {my_simplex.tuple()};
+    }
+    if (other_manager.m_parent == &my_mesh) {
+        return map_to_child_tuples(my_mesh, m_children[other_manager.m_child_id], my_simplex);
+    }
+    if (m_parent == &other_mesh) {
+        return {map_tuple_to_parent_tuple(my_mesh, my_simplex.tuple())};
+    }
+
+    const Mesh& lub = least_upper_bound(my_mesh, other_mesh);
+    const int64_t depth = this->depth() - lub.m_multi_mesh_manager.depth();
 
     auto [local_root_ref, tuple] = map_up_to_tuples(my_mesh, my_simplex, depth);
-    assert(other_mesh.m_multi_mesh_manager.is_child(other_mesh, local_root_ref));
+    assert(&local_root_ref == &lub);
 
     const simplex::Simplex simplex(my_simplex.primitive_type(), tuple);
 
-    auto other_relative_id = relative_id(lub_id, other_id);
+    IdPath other_relative_id;
+    relative_id_path(other_mesh, local_root_ref, other_relative_id);
     return local_root_ref.m_multi_mesh_manager.map_down_relative_tuples(
         local_root_ref,
         simplex,
@@ -679,7 +703,7 @@ void MultiMeshManager::update_map_tuple_hashes(
 
     const PrimitiveType parent_primitive_type = my_mesh.top_simplex_type();
 
-    auto parent_hash_accessor = my_mesh.get_const_cell_hash_accessor();
+    const auto& parent_hash_accessor = my_mesh.get_const_cell_hash_accessor();
     auto parent_flag_accessor = my_mesh.get_const_flag_accessor(primitive_type);
     // auto& update_tuple = [&](const auto& flag_accessor, Tuple& t) -> bool {
     //     if(acc.index_access().
@@ -702,7 +726,7 @@ void MultiMeshManager::update_map_tuple_hashes(
         auto& [parent_to_child_accessor, child_to_parent_accessor] = maps;
 
         auto child_flag_accessor = child_mesh.get_const_flag_accessor(primitive_type);
-        auto child_hash_accessor = child_mesh.get_const_cell_hash_accessor();
+        const auto& child_hash_accessor = child_mesh.get_const_cell_hash_accessor();
 
 
         std::vector<bool> is_gid_visited(my_mesh.capacity(primitive_type), false);
@@ -1180,6 +1204,45 @@ void MultiMeshManager::check_child_map_valid(const Mesh& my_mesh, const ChildDat
 }
 
 
+int64_t MultiMeshManager::depth() const
+{
+    int64_t depth = 0;
+    for (const Mesh* m = m_parent; m != nullptr; m = m->m_multi_mesh_manager.m_parent) {
+        ++depth;
+    }
+    return depth;
+}
+
+void MultiMeshManager::relative_id_path(const Mesh& my_mesh, const Mesh& ancestor, IdPath& path)
+{
+    path.clear();
+    for (const Mesh* m = &my_mesh; m != &ancestor; m = m->m_multi_mesh_manager.m_parent) {
+        assert(m != nullptr);
+        path.push_back(m->m_multi_mesh_manager.m_child_id);
+    }
+    std::reverse(path.begin(), path.end());
+}
+
+const Mesh& MultiMeshManager::least_upper_bound(const Mesh& a, const Mesh& b)
+{
+    const Mesh* a_ptr = &a;
+    const Mesh* b_ptr = &b;
+    int64_t a_depth = a.m_multi_mesh_manager.depth();
+    int64_t b_depth = b.m_multi_mesh_manager.depth();
+    for (; a_depth > b_depth; --a_depth) {
+        a_ptr = a_ptr->m_multi_mesh_manager.m_parent;
+    }
+    for (; b_depth > a_depth; --b_depth) {
+        b_ptr = b_ptr->m_multi_mesh_manager.m_parent;
+    }
+    while (a_ptr != b_ptr) {
+        a_ptr = a_ptr->m_multi_mesh_manager.m_parent;
+        b_ptr = b_ptr->m_multi_mesh_manager.m_parent;
+        assert(a_ptr != nullptr && b_ptr != nullptr);
+    }
+    return *a_ptr;
+}
+
 std::vector<int64_t> MultiMeshManager::least_upper_bound_id(
     const std::vector<int64_t>& a,
     const std::vector<int64_t>& b)
@@ -1245,14 +1308,11 @@ bool MultiMeshManager::can_map_child(
     if (my_simplex.primitive_type() > other_mesh.top_simplex_type()) {
         return false;
     }
-    const auto my_id = absolute_id();
-    const auto other_id = other_mesh.absolute_multi_mesh_id();
-
-    int64_t depth = my_id.size();
-
-    auto [root_ref, tuple] = map_up_to_tuples(my_mesh, my_simplex, depth);
+    auto [root_ref, tuple] = map_up_to_tuples(my_mesh, my_simplex, depth());
     const simplex::Simplex simplex(my_simplex.primitive_type(), tuple);
 
+    IdPath other_id;
+    relative_id_path(other_mesh, root_ref, other_id);
     return !root_ref.m_multi_mesh_manager.map_down_relative_tuples(root_ref, simplex, other_id)
                 .empty();
 }
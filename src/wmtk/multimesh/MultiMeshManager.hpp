@@ -8,6 +8,7 @@
 #include <wmtk/multimesh/same_simplex_dimension_surjection.hpp>
 #include <wmtk/operations/utils/UpdateVertexMultiMeshMapHash.hpp>
 #include <wmtk/utils/MerkleTreeInteriorNode.hpp>
+#include <wmtk/utils/SmallVector.hpp>
 
 
 namespace wmtk {
@@ -481,13 +482,25 @@ protected: // protected to enable unit testing
     std::pair<const Mesh&, Tuple>
     map_up_to_tuples(const Mesh& my_mesh, const simplex::Simplex& simplex, int64_t depth) const;
 
+    // a path of child ids through the multimesh tree, stored inline for the usual shallow trees
+    using IdPath = wmtk::utils::SmallVector<int64_t, 8>;
+
     // internal function for mapping down a multimesh tree by following a sequence of ids
     //
     // @return the mesh found at the top and the tuple that was found
     std::vector<Tuple> map_down_relative_tuples(
         const Mesh& my_mesh,
         const simplex::Simplex& my_simplex,
-        const std::vector<int64_t>& local_id_path) const;
+        const IdPath& local_id_path) const;
+
+    // the number of edges between this mesh and the root, found without allocating
+    int64_t depth() const;
+
+    // fills path with the child ids leading from ancestor down to my_mesh
+    static void relative_id_path(const Mesh& my_mesh, const Mesh& ancestor, IdPath& path);
+
+    // the deepest mesh that is an ancestor of both meshes, or either one of them
+    static const Mesh& least_upper_bound(const Mesh& a, const Mesh& b);
 
 
     static std::vector<int64_t> least_upper_bound_id(
@@ -20,4 +20,18 @@ void consolidate(Mesh& mesh)
     multimesh::MultiMeshVisitor visitor(run);
     visitor.execute_from_root(mesh);
 }
+
+std::map<std::vector<int64_t>, std::vector<std::vector<std::array<int64_t, 2>>>>
+consolidate_incremental(Mesh& mesh)
+{
+    std::map<std::vector<int64_t>, std::vector<std::vector<std::array<int64_t, 2>>>> moves;
+    auto run = [&](auto&& m) {
+        if constexpr (!std::is_const_v<std::remove_reference_t<decltype(m)>>) {
+            moves[m.absolute_multi_mesh_id()] = m.consolidate_incremental();
+        }
+    };
+    multimesh::MultiMeshVisitor visitor(run);
+    visitor.execute_from_root(mesh);
+    return moves;
+}
 } // namespace wmtk::multimesh
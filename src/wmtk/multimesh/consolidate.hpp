@@ -1,8 +1,19 @@
 #pragma once
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
 namespace wmtk {
 class Mesh;
 }
 
 namespace wmtk::multimesh {
 void consolidate(Mesh& m);
-}
+/**
+ * @brief Mesh::consolidate_incremental on every mesh of the multimesh of m.
+ *
+ * @return the moved simplices of every mesh, by absolute multimesh id
+ */
+std::map<std::vector<int64_t>, std::vector<std::vector<std::array<int64_t, 2>>>>
+consolidate_incremental(Mesh& m);
+} // namespace wmtk::multimesh
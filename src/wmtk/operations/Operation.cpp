@@ -1,17 +1,10 @@
 #include "Operation.hpp"
 
 #include <wmtk/Mesh.hpp>
-#include <wmtk/multimesh/MultiMeshVisitor.hpp>
 #include <wmtk/simplex/closed_star.hpp>
 #include <wmtk/simplex/top_dimension_cofaces.hpp>
 
 
-// it's ugly but for teh visitor we need these included
-#include <wmtk/EdgeMesh.hpp>
-#include <wmtk/PointMesh.hpp>
-#include <wmtk/TetMesh.hpp>
-#include <wmtk/TriMesh.hpp>
-
 namespace wmtk::operations {
 
 
@@ -80,15 +73,19 @@ std::vector<simplex::Simplex> Operation::operator()(const simplex::Simplex& simp
 
 bool Operation::before(const simplex::Simplex& simplex) const
 {
-    const attribute::Accessor<int64_t> accessor = hash_accessor();
-
-    if (!mesh().is_valid(simplex.tuple(), accessor)) {
+    if (!mesh().is_valid_current(simplex.tuple())) {
         return false;
     }
+    assert(mesh().is_valid(simplex.tuple(), hash_accessor()));
 
     // map simplex to the invariant mesh
     const Mesh& invariant_mesh = m_invariants.mesh();
 
+    // mapping a root mesh to itself is the identity, skip building the simplex vector
+    if (&invariant_mesh == &m_mesh && m_mesh.is_multi_mesh_root()) {
+        return m_invariants.before(simplex);
+    }
+
     // TODO check if this is correct
     const std::vector<simplex::Simplex> invariant_simplices = m_mesh.map(invariant_mesh, simplex);
 
@@ -152,28 +149,9 @@ attribute::Accessor<int64_t> Operation::hash_accessor()
     return m_mesh.get_cell_hash_accessor();
 }
 
-const attribute::Accessor<int64_t> Operation::hash_accessor() const
+const attribute::Accessor<int64_t>& Operation::hash_accessor() const
 {
     return m_mesh.get_const_cell_hash_accessor();
 }
 
-
-void Operation::reserve_enough_simplices()
-{
-    // by default assume we'll at most create N * capacity
-    constexpr static int64_t default_preallocation_size = 3;
-
-    auto run = [&](auto&& m) {
-        if constexpr (!std::is_const_v<std::remove_reference_t<decltype(m)>>) {
-            auto cap = m.m_attribute_manager.m_capacities;
-            for (auto& v : cap) {
-                v *= default_preallocation_size;
-            }
-            m.reserve_more_attributes(cap);
-        }
-    };
-    multimesh::MultiMeshVisitor visitor(run);
-    visitor.execute_from_root(mesh());
-}
-
 } // namespace wmtk::operations
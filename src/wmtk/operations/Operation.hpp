@@ -2,6 +2,7 @@
 
 #include "attribute_new/NewAttributeStrategy.hpp"
 #include "attribute_update/AttributeTransferStrategyBase.hpp"
+#include "PriorityKey.hpp"
 
 #include <wmtk/attribute/Accessor.hpp>
 #include <wmtk/Tuple.hpp>
@@ -32,9 +33,12 @@ public:
     // main entry point of the operator by the scheduler
     std::vector<simplex::Simplex> operator()(const simplex::Simplex& simplex);
 
-    virtual std::vector<double> priority(const simplex::Simplex& simplex) const
+    /**
+     * @brief priority of the simplex, the scheduler processes smaller keys first
+     */
+    virtual PriorityKey priority(const simplex::Simplex& simplex) const
     {
-        return m_priority == nullptr ? std::vector<double>({0}) : m_priority(simplex);
+        return m_priority == nullptr ? PriorityKey(0) : m_priority(simplex);
     }
 
     bool use_random_priority() const { return m_use_random_priority; }
@@ -47,11 +51,22 @@ public:
 
     void add_invariant(std::shared_ptr<Invariant> invariant) { m_invariants.add(invariant); }
 
-    void set_priority(const std::function<std::vector<double>(const simplex::Simplex&)>& func)
+    void set_priority(const std::function<PriorityKey(const simplex::Simplex&)>& func)
     {
         m_priority = func;
     }
 
+    /**
+     * @brief adapter for priorities returning a std::vector<double>, prefer returning a
+     * PriorityKey (or a double) to avoid one allocation per call
+     */
+    void set_priority(const std::function<std::vector<double>(const simplex::Simplex&)>& func)
+    {
+        m_priority = [func](const simplex::Simplex& s) {
+            return PriorityKey::from_vector(func(s));
+        };
+    }
+
     std::shared_ptr<operations::AttributeTransferStrategyBase> get_transfer_strategy(
         const attribute::MeshAttributeHandle& attribute);
 
@@ -63,8 +78,6 @@ public:
         const attribute::MeshAttributeHandle& attribute,
         const std::shared_ptr<operations::AttributeTransferStrategyBase>& other);
 
-    virtual void reserve_enough_simplices();
-
 protected:
     /**
      * @brief returns an empty vector in case of failure
@@ -91,7 +104,7 @@ protected:
     /// @brief utility for subclasses
     attribute::Accessor<int64_t> hash_accessor();
     /// @brief utility for subclasses
-    const attribute::Accessor<int64_t> hash_accessor() const;
+    const attribute::Accessor<int64_t>& hash_accessor() const;
 
 
     void apply_attribute_transfer(const std::vector<simplex::Simplex>& direct_mods);
@@ -101,7 +114,7 @@ private:
     Mesh& m_mesh;
     bool m_use_random_priority = false;
 
-    std::function<std::vector<double>(const simplex::Simplex&)> m_priority = nullptr;
+    std::function<PriorityKey(const simplex::Simplex&)> m_priority = nullptr;
 
 protected:
     invariants::InvariantCollection m_invariants;
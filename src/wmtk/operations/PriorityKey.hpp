@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace wmtk::operations {
+
+/**
+ * @brief Fixed-width lexicographic priority of a simplex, smaller keys are processed first.
+ *
+ * Holds up to max_size values inline so computing and comparing priorities never allocates.
+ * The comparison matches the one of std::vector<double>: values are compared lexicographically
+ * and a key that is a prefix of another one comes first. Unlike for the vector, NaN equals NaN and
+ * comes after every other value, so that degenerate simplices keep a strict weak ordering and are
+ * processed last.
+ */
+class PriorityKey
+{
+public:
+    static constexpr int64_t max_size = 4;
+
+    PriorityKey() = default;
+    PriorityKey(double value)
+        : m_size(1)
+    {
+        m_values[0] = value;
+    }
+    PriorityKey(std::initializer_list<double> values) { assign(values.begin(), values.end()); }
+
+    /**
+     * @brief adapter for the std::vector<double> priorities, throws if the vector has more than
+     * max_size entries
+     */
+    static PriorityKey from_vector(const std::vector<double>& values)
+    {
+        PriorityKey key;
+        key.assign(values.begin(), values.end());
+        return key;
+    }
+
+    std::vector<double> to_vector() const { return std::vector<double>(begin(), end()); }
+
+    int64_t size() const { return m_size; }
+    double operator[](int64_t index) const { return m_values[index]; }
+
+    const double* begin() const { return m_values.data(); }
+    const double* end() const { return m_values.data() + m_size; }
+
+    bool operator<(const PriorityKey& o) const
+    {
+        return std::lexicographical_compare(begin(), end(), o.begin(), o.end(), &value_less);
+    }
+    bool operator==(const PriorityKey& o) const
+    {
+        return m_size == o.m_size && std::equal(begin(), end(), o.begin(), &value_equal);
+    }
+    bool operator!=(const PriorityKey& o) const { return !(*this == o); }
+
+private:
+    static bool value_less(double a, double b)
+    {
+        return !std::isnan(a) && (std::isnan(b) || a < b);
+    }
+    static bool value_equal(double a, double b)
+    {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    }
+
+    template <typename It>
+    void assign(It first, It last)
+    {
+        const auto n = std::distance(first, last);
+        if (n > max_size) {
+            throw std::runtime_error(
+                "PriorityKey can hold at most " + std::to_string(max_size) + " values");
+        }
+        std::copy(first, last, m_values.begin());
+        m_size = static_cast<int8_t>(n);
+    }
+
+    std::array<double, max_size> m_values = {};
+    int8_t m_size = 0;
+};
+
+} // namespace wmtk::operations
@@ -1,12 +1,25 @@
 #include "ProjectOperation.hpp"
 
 #include <wmtk/Mesh.hpp>
-#include <wmtk/simplex/faces_single_dimension.hpp>
+#include <wmtk/envelope/EnvelopeIndex.hpp>
 
 #include <SimpleBVH/BVH.hpp>
 
 namespace wmtk::operations::composite {
 
+namespace {
+std::vector<ProjectOperation::EnvelopeConstrainPair> to_envelope_constrain_pairs(
+    const std::vector<ProjectOperation::MeshConstrainPair>& mesh_constaint_pairs)
+{
+    std::vector<ProjectOperation::EnvelopeConstrainPair> pairs;
+    pairs.reserve(mesh_constaint_pairs.size());
+    for (const auto& pair : mesh_constaint_pairs) {
+        pairs.emplace_back(std::make_shared<envelope::EnvelopeIndex>(pair.first), pair.second);
+    }
+    return pairs;
+}
+} // namespace
+
 ProjectOperation::ProjectOperation(
     std::shared_ptr<Operation> main_op,
     const attribute::MeshAttributeHandle& project_to_mesh,
@@ -18,43 +31,17 @@ ProjectOperation::ProjectOperation(
 ProjectOperation::ProjectOperation(
     std::shared_ptr<Operation> main_op,
     const std::vector<MeshConstrainPair>& mesh_constaint_pairs)
+    : ProjectOperation(main_op, to_envelope_constrain_pairs(mesh_constaint_pairs))
+{}
+
+ProjectOperation::ProjectOperation(
+    std::shared_ptr<Operation> main_op,
+    const std::vector<EnvelopeConstrainPair>& envelope_constaint_pairs)
     : AttributesUpdate(main_op->mesh())
     , m_main_op(main_op)
 {
-    for (auto& pair : mesh_constaint_pairs) {
-        int64_t count = 0;
-        int64_t index = 0;
-        const attribute::Accessor<double> accessor = pair.first.mesh().create_const_accessor(pair.first.as<double>());
-
-        const std::vector<Tuple>& facest =
-            pair.first.mesh().get_all(pair.first.mesh().top_simplex_type());
-
-        const int64_t dim = int64_t(pair.first.mesh().top_simplex_type()) + 1;
-
-        Eigen::MatrixXd vertices(dim * facest.size(), accessor.dimension());
-        Eigen::MatrixXi faces(facest.size(), dim);
-
-        for (const auto& f : facest) {
-            auto tmp = faces_single_dimension_tuples(
-                pair.first.mesh(),
-                simplex::Simplex(pair.first.mesh().top_simplex_type(), f),
-                PrimitiveType::Vertex);
-
-            assert(tmp.size() == dim);
-            for (int64_t j = 0; j < tmp.size(); ++j) {
-                auto p = accessor.const_vector_attribute(tmp[j]);
-                faces(index, j) = count;
-                vertices.row(dim * index + j) = p;
-
-                ++count;
-            }
-            ++index;
-        }
-
-        auto bvh = std::make_shared<SimpleBVH::BVH>();
-        bvh->init(vertices, faces, 1e-10);
-
-        m_bvh.emplace_back(pair.second, bvh);
+    for (const auto& pair : envelope_constaint_pairs) {
+        m_bvh.emplace_back(pair.second, pair.first->bvh());
     }
 }
 
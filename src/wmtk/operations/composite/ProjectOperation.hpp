@@ -7,6 +7,9 @@
 namespace SimpleBVH {
 class BVH;
 }
+namespace wmtk::envelope {
+class EnvelopeIndex;
+}
 
 namespace wmtk::operations::composite {
 class ProjectOperation : public AttributesUpdate
@@ -24,6 +27,18 @@ public:
         std::shared_ptr<Operation> main_op,
         const std::vector<MeshConstrainPair>& mesh_constaint_pairs);
 
+    // the envelope geometry and the coordinates projected onto it
+    using EnvelopeConstrainPair =
+        std::pair<std::shared_ptr<envelope::EnvelopeIndex>, attribute::MeshAttributeHandle>;
+
+    /**
+     * @brief Projects onto envelopes whose geometry is shared with other operations and
+     * invariants.
+     */
+    ProjectOperation(
+        std::shared_ptr<Operation> main_op,
+        const std::vector<EnvelopeConstrainPair>& envelope_constaint_pairs);
+
     std::vector<simplex::Simplex> execute(const simplex::Simplex& simplex) override;
     PrimitiveType primitive_type() const override { return m_main_op->primitive_type(); }
 
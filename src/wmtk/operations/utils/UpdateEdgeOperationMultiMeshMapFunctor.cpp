@@ -104,7 +104,7 @@ void UpdateEdgeOperationMultiMeshMapFunctor::update_ear_replacement(
 {
     const auto& parent_incident_datas = fmoe.incident_face_datas();
     auto& parent_mmmanager = m.m_multi_mesh_manager;
-    auto parent_hash_accessor = m.get_const_cell_hash_accessor();
+    const auto& parent_hash_accessor = m.get_const_cell_hash_accessor();
     const auto& parent_incident_vids = fmoe.incident_vids();
 
     for (const auto& parent_data : parent_incident_datas) {
@@ -115,7 +115,7 @@ void UpdateEdgeOperationMultiMeshMapFunctor::update_ear_replacement(
 
                 const auto& child_mmmanager = child_ptr->m_multi_mesh_manager;
                 int64_t child_id = child_mmmanager.child_id();
-                auto child_hash_accessor = child_ptr->get_const_cell_hash_accessor();
+                const auto& child_hash_accessor = child_ptr->get_const_cell_hash_accessor();
                 auto child_to_parent_handle = child_mmmanager.map_to_parent_handle;
                 auto parent_to_child_handle = parent_mmmanager.children().at(child_id).map_handle;
                 auto child_to_parent_accessor = child_ptr->create_accessor(child_to_parent_handle);
@@ -200,7 +200,7 @@ void UpdateEdgeOperationMultiMeshMapFunctor::update_ear_replacement(
     const auto& parent_incident_tet_datas = tmoe.incident_tet_datas();
     const auto& parent_incident_face_datas = tmoe.incident_face_datas();
     auto parent_mmmanager = m.m_multi_mesh_manager;
-    auto parent_hash_accessor = m.get_const_cell_hash_accessor();
+    const auto& parent_hash_accessor = m.get_const_cell_hash_accessor();
 
     for (const auto& parent_data : parent_incident_tet_datas) {
         for (int ear_index = 0; ear_index < 2; ++ear_index) {
@@ -210,7 +210,7 @@ void UpdateEdgeOperationMultiMeshMapFunctor::update_ear_replacement(
                     // update merge faces here
                     const auto& child_mmmanager = child_ptr->m_multi_mesh_manager;
                     const int64_t child_id = child_mmmanager.child_id();
-                    auto child_hash_accessor = child_ptr->get_const_cell_hash_accessor();
+                    const auto& child_hash_accessor = child_ptr->get_const_cell_hash_accessor();
                     const auto child_to_parent_handle = child_mmmanager.map_to_parent_handle;
                     const auto parent_to_child_handle =
                         parent_mmmanager.children().at(child_id).map_handle;
@@ -308,7 +308,7 @@ void UpdateEdgeOperationMultiMeshMapFunctor::update_ear_replacement(
                     // there are three ear edges per side
                     const auto& child_mmmanager = child_ptr->m_multi_mesh_manager;
                     int64_t child_id = child_mmmanager.child_id();
-                    auto child_hash_accessor = child_ptr->get_const_cell_hash_accessor();
+                    const auto& child_hash_accessor = child_ptr->get_const_cell_hash_accessor();
                     auto child_to_parent_handle = child_mmmanager.map_to_parent_handle;
                     auto parent_to_child_handle =
                         parent_mmmanager.children().at(child_id).map_handle;
@@ -11,7 +11,7 @@ RawSimplex::RawSimplex(const Mesh& mesh, const std::vector<Tuple>& vertices)
 {
     m_vertices.reserve(vertices.size());
 
-    const attribute::Accessor<int64_t> hash_accessor = mesh.get_const_cell_hash_accessor();
+    const attribute::Accessor<int64_t>& hash_accessor = mesh.get_const_cell_hash_accessor();
 
     for (size_t i = 0; i < vertices.size(); ++i) {
         m_vertices.emplace_back(
@@ -82,7 +82,7 @@ RawSimplex RawSimplex::opposite_face(const int64_t excluded_id)
 
 RawSimplex RawSimplex::opposite_face(const Mesh& mesh, const Tuple& vertex)
 {
-    const attribute::Accessor<int64_t> hash_accessor = mesh.get_const_cell_hash_accessor();
+    const attribute::Accessor<int64_t>& hash_accessor = mesh.get_const_cell_hash_accessor();
 
     int64_t excluded_id =
         mesh.is_valid(vertex, hash_accessor) ? mesh.id(vertex, PrimitiveType::Vertex) : -1;
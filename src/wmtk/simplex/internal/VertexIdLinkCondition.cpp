@@ -0,0 +1,229 @@
+#include "VertexIdLinkCondition.hpp"
+
+#include <algorithm>
+
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/TriMesh.hpp>
+#include <wmtk/attribute/Accessor.hpp>
+#include <wmtk/simplex/Simplex.hpp>
+#include <wmtk/simplex/top_dimension_cofaces.hpp>
+#include <wmtk/utils/SmallVector.hpp>
+
+namespace wmtk::simplex::internal {
+
+namespace {
+constexpr PrimitiveType PV = PrimitiveType::Vertex;
+
+template <size_t N>
+using IdVector = wmtk::utils::SmallVector<int64_t, N>;
+
+template <size_t N>
+void sort_and_unique_ids(IdVector<N>& ids)
+{
+    std::sort(ids.begin(), ids.end());
+    ids.resize(std::distance(ids.begin(), std::unique(ids.begin(), ids.end())));
+}
+
+// number of ids contained in both sorted vectors
+template <size_t N, size_t M>
+int64_t count_common(const IdVector<N>& a, const IdVector<M>& b)
+{
+    int64_t count = 0;
+    const int64_t* ia = a.begin();
+    const int64_t* ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+        if (*ia < *ib) {
+            ++ia;
+        } else if (*ib < *ia) {
+            ++ib;
+        } else {
+            ++count;
+            ++ia;
+            ++ib;
+        }
+    }
+    return count;
+}
+
+// The link of a vertex with the ids of its simplices sorted per dimension. The boundary simplices
+// are the link simplices that are joined with the dummy vertex of the boundary.
+template <size_t NV, size_t NE, size_t NF, size_t NB>
+struct VertexLink
+{
+    IdVector<NV> vertices;
+    IdVector<NE> edges;
+    IdVector<NF> faces;
+    IdVector<NB> boundary;
+
+    void sort_and_unique()
+    {
+        sort_and_unique_ids(vertices);
+        sort_and_unique_ids(edges);
+        sort_and_unique_ids(faces);
+        sort_and_unique_ids(boundary);
+    }
+};
+
+using TriVertexLink = VertexLink<64, 32, 1, 8>;
+using TetVertexLink = VertexLink<64, 128, 64, 64>;
+
+// closed mesh check: link(a) \intersect link(b) == link(ab). As link(ab) is always part of the
+// intersection comparing the sizes is enough.
+template <typename Link>
+bool closed_link_condition(
+    const Link& link_a,
+    const Link& link_b,
+    int64_t n_edge_link_vertices,
+    int64_t n_edge_link_edges)
+{
+    return count_common(link_a.vertices, link_b.vertices) == n_edge_link_vertices &&
+           count_common(link_a.edges, link_b.edges) == n_edge_link_edges &&
+           count_common(link_a.faces, link_b.faces) == 0;
+}
+
+// the dummy vertex joined to the boundary is in link(ab) iff ab is a boundary edge
+template <typename Link>
+bool boundary_link_condition(const Link& link_a, const Link& link_b, bool is_boundary_edge)
+{
+    if (is_boundary_edge) {
+        // a common boundary simplex is joined with the dummy vertex in both links
+        return count_common(link_a.boundary, link_b.boundary) == 0;
+    } else {
+        // the dummy vertex is in the intersection but not in link(ab)
+        return link_a.boundary.empty() || link_b.boundary.empty();
+    }
+}
+} // namespace
+
+bool VertexIdLinkCondition::link_condition(const TriMesh& mesh, const Tuple& edge)
+{
+    TopDimensionCofacesBuffer faces;
+
+    // for every triangle around v: the two other vertices, the edge opposite to v and the
+    // endpoints of the boundary edges incident to v. Local edge i is opposite to local vertex i.
+    auto gather_link = [&](const Tuple& v, TriVertexLink& link) {
+        const int64_t v_id = mesh.id(v, PV);
+        faces.clear();
+        top_dimension_cofaces_tuples(mesh, Simplex::vertex(v), faces);
+        for (const Tuple& f : faces) {
+            const auto fv = mesh.m_fv_accessor->const_vector_attribute<3>(f);
+            const auto fe = mesh.m_fe_accessor->const_vector_attribute<3>(f);
+            const auto ff = mesh.m_ff_accessor->const_vector_attribute<3>(f);
+
+            const int64_t lv = fv[0] == v_id ? 0 : (fv[1] == v_id ? 1 : 2);
+            link.edges.push_back(fe[lv]);
+            for (int64_t i = 0; i < 3; ++i) {
+                if (i == lv) {
+                    continue;
+                }
+                link.vertices.push_back(fv[i]);
+                // the edge from v to i is opposite to the third vertex
+                if (ff[3 - lv - i] < 0) {
+                    link.boundary.push_back(fv[i]);
+                }
+            }
+        }
+        link.sort_and_unique();
+    };
+
+    TriVertexLink link_a;
+    TriVertexLink link_b;
+    gather_link(edge, link_a);
+    gather_link(mesh.switch_vertex(edge), link_b);
+
+    // link(ab) consists of the vertices opposite to ab
+    const bool is_boundary_edge = mesh.is_boundary_edge(edge);
+    int64_t n_edge_link_vertices = 1;
+    if (!is_boundary_edge) {
+        const int64_t c = mesh.id(mesh.switch_vertex(mesh.switch_edge(edge)), PV);
+        const int64_t d =
+            mesh.id(mesh.switch_vertex(mesh.switch_edge(mesh.switch_face(edge))), PV);
+        n_edge_link_vertices = c == d ? 1 : 2;
+    }
+
+    return closed_link_condition(link_a, link_b, n_edge_link_vertices, 0) &&
+           boundary_link_condition(link_a, link_b, is_boundary_edge);
+}
+
+bool VertexIdLinkCondition::link_condition(const TetMesh& mesh, const Tuple& edge)
+{
+    using wmtk::autogen::tet_mesh::auto_3d_edges;
+
+    TopDimensionCofacesBuffer tets;
+
+    // for every tet around v: the triangle opposite to v with its edges and vertices and the edges
+    // opposite to v of the boundary triangles incident to v. Local face i is opposite to local
+    // vertex i.
+    auto gather_link = [&](const Tuple& v, TetVertexLink& link) {
+        const int64_t v_id = mesh.id(v, PV);
+        tets.clear();
+        top_dimension_cofaces_tuples(mesh, Simplex::vertex(v), tets);
+        for (const Tuple& t : tets) {
+            const auto tv = mesh.m_tv_accessor->const_vector_attribute<4>(t);
+            const auto te = mesh.m_te_accessor->const_vector_attribute<6>(t);
+            const auto tf = mesh.m_tf_accessor->const_vector_attribute<4>(t);
+            const auto tt = mesh.m_tt_accessor->const_vector_attribute<4>(t);
+
+            int64_t lv = 0;
+            while (tv[lv] != v_id) {
+                ++lv;
+            }
+            link.faces.push_back(tf[lv]);
+            for (int64_t i = 0; i < 4; ++i) {
+                if (i != lv) {
+                    link.vertices.push_back(tv[i]);
+                }
+            }
+            for (int64_t i = 0; i < 6; ++i) {
+                const int64_t a = auto_3d_edges[i][0];
+                const int64_t b = auto_3d_edges[i][1];
+                if (a == lv || b == lv) {
+                    continue;
+                }
+                link.edges.push_back(te[i]);
+                // the triangle spanned by v and this edge is opposite to the remaining vertex
+                if (tt[6 - lv - a - b] < 0) {
+                    link.boundary.push_back(te[i]);
+                }
+            }
+        }
+        link.sort_and_unique();
+    };
+
+    TetVertexLink link_a;
+    TetVertexLink link_b;
+    gather_link(edge, link_a);
+    gather_link(mesh.switch_vertex(edge), link_b);
+
+    // link(ab) consists of the edges opposite to ab and their vertices
+    const int64_t a_id = mesh.id(edge, PV);
+    const int64_t b_id = mesh.id(mesh.switch_vertex(edge), PV);
+    IdVector<32> edge_link_vertices;
+    IdVector<32> edge_link_edges;
+    tets.clear();
+    top_dimension_cofaces_tuples(mesh, Simplex::edge(edge), tets);
+    for (const Tuple& t : tets) {
+        const auto tv = mesh.m_tv_accessor->const_vector_attribute<4>(t);
+        const auto te = mesh.m_te_accessor->const_vector_attribute<6>(t);
+        for (int64_t i = 0; i < 6; ++i) {
+            const int64_t x = tv[auto_3d_edges[i][0]];
+            const int64_t y = tv[auto_3d_edges[i][1]];
+            if (x != a_id && x != b_id && y != a_id && y != b_id) {
+                edge_link_vertices.push_back(x);
+                edge_link_vertices.push_back(y);
+                edge_link_edges.push_back(te[i]);
+            }
+        }
+    }
+    sort_and_unique_ids(edge_link_vertices);
+    sort_and_unique_ids(edge_link_edges);
+
+    return closed_link_condition(
+               link_a,
+               link_b,
+               edge_link_vertices.size(),
+               edge_link_edges.size()) &&
+           boundary_link_condition(link_a, link_b, mesh.is_boundary_edge(edge));
+}
+
+} // namespace wmtk::simplex::internal
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <wmtk/Tuple.hpp>
+
+namespace wmtk {
+class TriMesh;
+class TetMesh;
+} // namespace wmtk
+
+namespace wmtk::simplex::internal {
+
+/**
+ * @brief Link condition of TriMesh and TetMesh computed on vertex ids.
+ *
+ * Instead of intersecting SimplexCollections, the links of both edge endpoints are gathered as
+ * small sorted arrays of vertex, edge and triangle ids read directly from the connectivity of the
+ * top simplices around each endpoint. Only the sizes of their intersections are compared against
+ * the link of the edge. The boundary handling is the same as in link_condition_from_links, so both
+ * return the same answers.
+ */
+class VertexIdLinkCondition
+{
+public:
+    static bool link_condition(const TriMesh& mesh, const Tuple& edge);
+    static bool link_condition(const TetMesh& mesh, const Tuple& edge);
+};
+
+} // namespace wmtk::simplex::internal
@@ -1,6 +1,7 @@
 #include "link_condition.hpp"
 #include <wmtk/utils/metaprogramming/as_mesh_variant.hpp>
 #include "cofaces_single_dimension.hpp"
+#include "internal/VertexIdLinkCondition.hpp"
 #include "link.hpp"
 #include "open_star.hpp"
 #include "utils/SimplexComparisons.hpp"
@@ -38,7 +39,7 @@ bool link_condition(const EdgeMesh& mesh, const Tuple& edge)
     return true;
 }
 
-bool link_condition(const TriMesh& mesh, const Tuple& edge)
+bool link_condition_from_links(const TriMesh& mesh, const Tuple& edge)
 {
     // step1 check link condition for closed case
     if (!link_condition_closed_trimesh(mesh, edge)) {
@@ -116,7 +117,7 @@ bool link_condition_closed_tetmesh(const TetMesh& mesh, const Tuple& edge)
     return SimplexCollection::are_simplex_collections_equal(link_a_link_b_intersection, link_ab);
 }
 
-bool link_condition(const TetMesh& mesh, const Tuple& edge)
+bool link_condition_from_links(const TetMesh& mesh, const Tuple& edge)
 {
     // close mesh check
     if (!link_condition_closed_tetmesh(mesh, edge)) {
@@ -191,6 +192,16 @@ bool link_condition(const TetMesh& mesh, const Tuple& edge)
     return true;
 }
 
+bool link_condition(const TriMesh& mesh, const Tuple& edge)
+{
+    return internal::VertexIdLinkCondition::link_condition(mesh, edge);
+}
+
+bool link_condition(const TetMesh& mesh, const Tuple& edge)
+{
+    return internal::VertexIdLinkCondition::link_condition(mesh, edge);
+}
+
 bool link_condition(const Mesh& mesh, const Tuple& edge)
 {
     return std::visit(
@@ -17,4 +17,14 @@ bool link_condition(const EdgeMesh& mesh, const Tuple& edge);
 bool link_condition(const TriMesh& mesh, const Tuple& edge);
 bool link_condition(const TetMesh& mesh, const Tuple& edge);
 bool link_condition(const Mesh& mesh, const Tuple& edge);
+
+/**
+ * @brief Reference implementation of the link condition that intersects the links of the edge
+ * endpoints as SimplexCollections.
+ *
+ * Considerably slower than link_condition, which compares the vertex neighborhoods by id. Kept to
+ * validate the fast version.
+ */
+bool link_condition_from_links(const TriMesh& mesh, const Tuple& edge);
+bool link_condition_from_links(const TetMesh& mesh, const Tuple& edge);
 } // namespace wmtk::simplex
@@ -1,378 +1,169 @@
 #include "top_dimension_cofaces.hpp"
+#include <algorithm>
 #include <wmtk/utils/Logger.hpp>
 #include <wmtk/utils/TupleCellLessThanFunctor.hpp>
 #include "utils/tuple_vector_to_homogeneous_simplex_vector.hpp"
 
-#include <queue>
-#include <set>
-
 #include <wmtk/EdgeMesh.hpp>
 #include <wmtk/TetMesh.hpp>
 #include <wmtk/TriMesh.hpp>
 
-#include "internal/SimplexLessFunctor.hpp"
-
 namespace wmtk::simplex {
 
 namespace {
 
-
-void top_dimension_cofaces_tuples_vertex(
-    const TriMesh& mesh,
-    const Tuple& t_in,
-    std::vector<Tuple>& collection)
-{
-    assert(mesh.is_valid_slow(t_in));
-    std::set<Tuple, wmtk::utils::TupleCellLessThan> touched_cells;
-    std::queue<Tuple> q;
-    q.push(t_in);
-    while (!q.empty()) {
-        const Tuple t = q.front();
-        q.pop();
-
-        {
-            // check if cell already exists
-            const auto [it, did_insert] = touched_cells.insert(t);
-            if (!did_insert) {
-                continue;
-            }
-        }
-        collection.emplace_back(t);
-
-        if (!mesh.is_boundary_edge(t)) {
-            q.push(mesh.switch_tuples(t, {PrimitiveType::Triangle, PrimitiveType::Edge}));
-        }
-        const Tuple t_other = mesh.switch_edge(t);
-        if (!mesh.is_boundary_edge(t_other)) {
-            q.push(mesh.switch_face(t_other));
-        }
-    }
-}
-void top_dimension_cofaces_tuples_edge(
-    const TriMesh& mesh,
-    const Tuple& t,
-    std::vector<Tuple>& collection)
-{
-    collection.emplace_back(t);
-    if (!mesh.is_boundary_edge(t)) {
-        collection.emplace_back(mesh.switch_face(t));
-    }
-}
-void top_dimension_cofaces_tuples_face(
-    const TriMesh& mesh,
-    const Tuple& t,
-    std::vector<Tuple>& collection)
-{
-    collection.emplace_back(t);
-}
-
-void top_dimension_cofaces_tuples_vertex(
-    const TetMesh& mesh,
-    const Tuple& input,
-    std::vector<Tuple>& collection)
-{
-    std::set<Tuple, wmtk::utils::TupleCellLessThan> touched_cells;
-    std::queue<Tuple> q;
-    q.push(input);
-    while (!q.empty()) {
-        const Tuple t = q.front();
-        q.pop();
-
-        {
-            // check if cell already exists
-            const auto& [it, was_inserted] = touched_cells.insert(t);
-            if (!was_inserted) {
-                continue;
-            }
-        }
-
-        collection.emplace_back(t);
-
-        const Tuple& t1 = t;
-        const Tuple t2 = mesh.switch_face(t);
-        const Tuple t3 = mesh.switch_tuples(t, {PrimitiveType::Edge, PrimitiveType::Triangle});
-
-        if (!mesh.is_boundary_face(t1)) {
-            q.push(mesh.switch_tetrahedron(t1));
-        }
-        if (!mesh.is_boundary_face(t2)) {
-            q.push(mesh.switch_tetrahedron(t2));
-        }
-        if (!mesh.is_boundary_face(t3)) {
-            q.push(mesh.switch_tetrahedron(t3));
-        }
-    }
-}
-void top_dimension_cofaces_tuples_edge(
-    const TetMesh& mesh,
-    const Tuple& input,
-    std::vector<Tuple>& collection)
-{
-    std::set<Tuple, wmtk::utils::TupleCellLessThan> touched_cells;
-    std::queue<Tuple> q;
-    q.push(input);
-    while (!q.empty()) {
-        const Tuple t = q.front();
-        q.pop();
-
-        {
-            // check if cell already exists
-            const auto& [it, was_inserted] = touched_cells.insert(t);
-            if (!was_inserted) {
-                continue;
-            }
-        }
-
-        collection.emplace_back(t);
-
-        const Tuple& t1 = t;
-        const Tuple t2 = mesh.switch_face(t);
-
-        if (!mesh.is_boundary_face(t1)) {
-            q.push(mesh.switch_tuples(t1, {PrimitiveType::Tetrahedron, PrimitiveType::Triangle}));
-        }
-        if (!mesh.is_boundary_face(t2)) {
-            q.push(mesh.switch_tetrahedron(t2));
-        }
-    }
-}
-
-void top_dimension_cofaces_tuples_face(
-    const TetMesh& mesh,
-    const Tuple& input,
-    std::vector<Tuple>& collection)
-{
-    collection.emplace_back(input);
-    if (!mesh.is_boundary_face(input)) {
-        collection.emplace_back(mesh.switch_tetrahedron(input));
-    }
-}
-void top_dimension_cofaces_tuples_tet(
-    const TetMesh& mesh,
-    const Tuple& t,
-    std::vector<Tuple>& collection)
-{
-    collection.emplace_back(t);
-}
-
-std::vector<Tuple> top_dimension_cofaces_tuples_vertex(const TriMesh& mesh, const Tuple& t)
-{
-    std::vector<Tuple> collection;
-    top_dimension_cofaces_tuples_vertex(mesh, t, collection);
-    return collection;
-}
-std::vector<Tuple> top_dimension_cofaces_tuples_edge(const TriMesh& mesh, const Tuple& t)
+bool is_same_cell(const Tuple& a, const Tuple& b)
 {
-    std::vector<Tuple> collection;
-    top_dimension_cofaces_tuples_edge(mesh, t, collection);
-    return collection;
-}
-std::vector<Tuple> top_dimension_cofaces_tuples_face(const TriMesh& mesh, const Tuple& t)
-{
-    std::vector<Tuple> collection;
-    top_dimension_cofaces_tuples_face(mesh, t, collection);
-    return collection;
+    const wmtk::utils::TupleCellLessThan less;
+    return !less(a, b) && !less(b, a);
 }
 
-std::vector<Tuple> top_dimension_cofaces_tuples_vertex(const TetMesh& mesh, const Tuple& input)
-{
-    std::vector<Tuple> collection;
-    top_dimension_cofaces_tuples_vertex(mesh, input, collection);
-    return collection;
-}
-std::vector<Tuple> top_dimension_cofaces_tuples_edge(const TetMesh& mesh, const Tuple& input)
-{
-    std::vector<Tuple> collection;
-    top_dimension_cofaces_tuples_edge(mesh, input, collection);
-    return collection;
-}
-std::vector<Tuple> top_dimension_cofaces_tuples_face(const TetMesh& mesh, const Tuple& input)
-{
-    std::vector<Tuple> collection;
-    top_dimension_cofaces_tuples_face(mesh, input, collection);
-    return collection;
-}
-std::vector<Tuple> top_dimension_cofaces_tuples_tet(const TetMesh& mesh, const Tuple& t)
-{
-    std::vector<Tuple> collection;
-    top_dimension_cofaces_tuples_tet(mesh, t, collection);
-    return collection;
-}
-
-
-} // namespace
-
-namespace {
-
+// The kernels below append to either a std::vector<Tuple> or a TopDimensionCofacesBuffer and
+// never allocate on their own.
 
+// Rotates around the vertex. If a boundary edge is hit the rotation continues from the input in
+// the other direction, so every triangle is visited exactly once without a visited set.
+template <typename Container>
 void top_dimension_cofaces_tuples_vertex(
     const TriMesh& mesh,
     const Tuple& t_in,
-    SimplexCollection& collection)
+    Container& collection)
 {
     assert(mesh.is_valid_slow(t_in));
-    std::set<Tuple, wmtk::utils::TupleCellLessThan> touched_cells;
-    std::queue<Tuple> q;
-    q.push(t_in);
-    while (!q.empty()) {
-        const Tuple t = q.front();
-        q.pop();
-
-        {
-            // check if cell already exists
-            const auto [it, did_insert] = touched_cells.insert(t);
-            if (!did_insert) {
-                continue;
+    Tuple t = t_in;
+    do {
+        collection.push_back(t);
+
+        if (mesh.is_boundary_edge(t)) {
+            t = mesh.switch_edge(t_in);
+            while (!mesh.is_boundary_edge(t)) {
+                t = mesh.switch_face(t);
+                collection.push_back(t);
+                t = mesh.switch_edge(t);
             }
+            return;
         }
-        collection.add(PrimitiveType::Triangle, t);
-
-        if (!mesh.is_boundary_edge(t)) {
-            q.push(mesh.switch_tuples(t, {PrimitiveType::Triangle, PrimitiveType::Edge}));
-        }
-        const Tuple t_other = mesh.switch_edge(t);
-        if (!mesh.is_boundary_edge(t_other)) {
-            q.push(mesh.switch_face(t_other));
-        }
-    }
+        t = mesh.switch_edge(mesh.switch_face(t));
+    } while (!is_same_cell(t, t_in));
 }
-void top_dimension_cofaces_tuples_edge(
-    const TriMesh& mesh,
-    const Tuple& t,
-    SimplexCollection& collection)
+template <typename Container>
+void top_dimension_cofaces_tuples_edge(const TriMesh& mesh, const Tuple& t, Container& collection)
 {
-    collection.add(PrimitiveType::Triangle, t);
+    collection.push_back(t);
     if (!mesh.is_boundary_edge(t)) {
-        collection.add(PrimitiveType::Triangle, mesh.switch_face(t));
+        collection.push_back(mesh.switch_face(t));
     }
 }
-void top_dimension_cofaces_tuples_face(
-    const TriMesh& mesh,
-    const Tuple& t,
-    SimplexCollection& collection)
+template <typename Container>
+void top_dimension_cofaces_tuples_face(const TriMesh& mesh, const Tuple& t, Container& collection)
 {
-    collection.add(PrimitiveType::Triangle, t);
+    collection.push_back(t);
 }
 
+// Depth first search over the tetrahedra around the vertex. The visited cells are kept sorted in
+// an inline buffer, so looking one up is a binary search and nothing is allocated for the
+// valences seen in practice.
+template <typename Container>
 void top_dimension_cofaces_tuples_vertex(
     const TetMesh& mesh,
     const Tuple& input,
-    SimplexCollection& collection)
-{
-    std::set<Tuple, wmtk::utils::TupleCellLessThan> touched_cells;
-    std::queue<Tuple> q;
-    q.push(input);
-    while (!q.empty()) {
-        const Tuple t = q.front();
-        q.pop();
-
-        {
-            // check if cell already exists
-            const auto& [it, was_inserted] = touched_cells.insert(t);
-            if (!was_inserted) {
-                continue;
-            }
+    Container& collection)
+{
+    const wmtk::utils::TupleCellLessThan less;
+    wmtk::utils::SmallVector<Tuple, 32> visited;
+    auto find = [&](const Tuple& t) {
+        return std::lower_bound(visited.begin(), visited.end(), t, less);
+    };
+    auto is_visited = [&](const Tuple& t) {
+        const auto it = find(t);
+        return it != visited.end() && !less(t, *it);
+    };
+
+    wmtk::utils::SmallVector<Tuple, 32> stack;
+    stack.push_back(input);
+    while (!stack.empty()) {
+        const Tuple t = stack.back();
+        stack.pop_back();
+
+        const auto it = find(t);
+        if (it != visited.end() && !less(t, *it)) {
+            continue;
         }
-
-        collection.add(PrimitiveType::Tetrahedron, t);
+        const size_t index = it - visited.begin();
+        visited.push_back(t);
+        std::rotate(visited.begin() + index, visited.end() - 1, visited.end());
+        collection.push_back(t);
 
         const Tuple& t1 = t;
         const Tuple t2 = mesh.switch_face(t);
         const Tuple t3 = mesh.switch_tuples(t, {PrimitiveType::Edge, PrimitiveType::Triangle});
 
-        if (!mesh.is_boundary_face(t1)) {
-            q.push(mesh.switch_tetrahedron(t1));
-        }
-        if (!mesh.is_boundary_face(t2)) {
-            q.push(mesh.switch_tetrahedron(t2));
-        }
-        if (!mesh.is_boundary_face(t3)) {
-            q.push(mesh.switch_tetrahedron(t3));
+        for (const Tuple& f : {t1, t2, t3}) {
+            if (!mesh.is_boundary_face(f)) {
+                const Tuple neighbor = mesh.switch_tetrahedron(f);
+                if (!is_visited(neighbor)) {
+                    stack.push_back(neighbor);
+                }
+            }
         }
     }
 }
+// Rotates around the edge, the same way the triangle version rotates around a vertex.
+template <typename Container>
 void top_dimension_cofaces_tuples_edge(
     const TetMesh& mesh,
     const Tuple& input,
-    SimplexCollection& collection)
-{
-    std::set<Tuple, wmtk::utils::TupleCellLessThan> touched_cells;
-    std::queue<Tuple> q;
-    q.push(input);
-    while (!q.empty()) {
-        const Tuple t = q.front();
-        q.pop();
-
-        {
-            // check if cell already exists
-            const auto& [it, was_inserted] = touched_cells.insert(t);
-            if (!was_inserted) {
-                continue;
+    Container& collection)
+{
+    Tuple t = input;
+    do {
+        collection.push_back(t);
+
+        if (mesh.is_boundary_face(t)) {
+            t = mesh.switch_face(input);
+            while (!mesh.is_boundary_face(t)) {
+                t = mesh.switch_tetrahedron(t);
+                collection.push_back(t);
+                t = mesh.switch_face(t);
             }
+            return;
         }
-
-        collection.add(PrimitiveType::Tetrahedron, t);
-
-        const Tuple& t1 = t;
-        const Tuple t2 = mesh.switch_face(t);
-
-        if (!mesh.is_boundary_face(t1)) {
-            q.push(mesh.switch_tuples(t1, {PrimitiveType::Tetrahedron, PrimitiveType::Triangle}));
-        }
-        if (!mesh.is_boundary_face(t2)) {
-            q.push(mesh.switch_tetrahedron(t2));
-        }
-    }
+        t = mesh.switch_face(mesh.switch_tetrahedron(t));
+    } while (!is_same_cell(t, input));
 }
-
+template <typename Container>
 void top_dimension_cofaces_tuples_face(
     const TetMesh& mesh,
     const Tuple& input,
-    SimplexCollection& collection)
+    Container& collection)
 {
-    collection.add(PrimitiveType::Tetrahedron, input);
+    collection.push_back(input);
     if (!mesh.is_boundary_face(input)) {
-        collection.add(PrimitiveType::Tetrahedron, mesh.switch_tetrahedron(input));
+        collection.push_back(mesh.switch_tetrahedron(input));
     }
 }
-void top_dimension_cofaces_tuples_tet(
-    const TetMesh& mesh,
-    const Tuple& t,
-    SimplexCollection& collection)
+template <typename Container>
+void top_dimension_cofaces_tuples_tet(const TetMesh& mesh, const Tuple& t, Container& collection)
 {
-    collection.add(PrimitiveType::Tetrahedron, t);
+    collection.push_back(t);
 }
 
-
-} // namespace
-
-void top_dimension_cofaces(
-    const Simplex& simplex,
-    SimplexCollection& simplex_collection,
-    const bool sort_and_clean)
-{
-    const auto& m = simplex_collection.mesh();
-    top_dimension_cofaces_tuples(m, simplex, simplex_collection);
-    if (sort_and_clean) {
-        simplex_collection.sort_and_clean();
-    }
-}
-
-void top_dimension_cofaces_tuples(
+template <typename Container>
+void append_top_dimension_cofaces(
     const EdgeMesh& mesh,
     const Simplex& simplex,
-    SimplexCollection& collection)
+    Container& collection)
 {
     switch (simplex.primitive_type()) {
     case PrimitiveType::Vertex: {
-        collection.add(simplex);
+        collection.push_back(simplex.tuple());
         if (!mesh.is_boundary_vertex(simplex.tuple())) {
-            collection.add(simplex.primitive_type(), mesh.switch_edge(simplex.tuple()));
+            collection.push_back(mesh.switch_edge(simplex.tuple()));
         }
         break;
     }
     case PrimitiveType::Edge: {
-        collection.add(simplex);
+        collection.push_back(simplex.tuple());
         break;
     }
     case PrimitiveType::Triangle: {
@@ -383,10 +174,11 @@ void top_dimension_cofaces_tuples(
     }
 }
 
-void top_dimension_cofaces_tuples(
+template <typename Container>
+void append_top_dimension_cofaces(
     const TriMesh& mesh,
     const Simplex& simplex,
-    SimplexCollection& collection)
+    Container& collection)
 {
     switch (simplex.primitive_type()) {
     case PrimitiveType::Vertex: {
@@ -406,10 +198,11 @@ void top_dimension_cofaces_tuples(
     }
 }
 
-void top_dimension_cofaces_tuples(
+template <typename Container>
+void append_top_dimension_cofaces(
     const TetMesh& mesh,
     const Simplex& simplex,
-    SimplexCollection& collection)
+    Container& collection)
 {
     switch (simplex.primitive_type()) {
     case PrimitiveType::Vertex: {
@@ -432,52 +225,91 @@ void top_dimension_cofaces_tuples(
     }
 }
 
-void top_dimension_cofaces_tuples(
-    const Mesh& mesh,
-    const Simplex& simplex,
-    SimplexCollection& collection)
+template <typename Container>
+void append_top_dimension_cofaces(const Mesh& mesh, const Simplex& simplex, Container& collection)
 {
     switch (mesh.top_simplex_type()) {
     case PrimitiveType::Triangle:
-        top_dimension_cofaces_tuples(static_cast<const TriMesh&>(mesh), simplex, collection);
+        append_top_dimension_cofaces(static_cast<const TriMesh&>(mesh), simplex, collection);
         break;
     case PrimitiveType::Tetrahedron:
-        top_dimension_cofaces_tuples(static_cast<const TetMesh&>(mesh), simplex, collection);
+        append_top_dimension_cofaces(static_cast<const TetMesh&>(mesh), simplex, collection);
         break;
     case PrimitiveType::Vertex:
     case PrimitiveType::Edge:
-        top_dimension_cofaces_tuples(static_cast<const EdgeMesh&>(mesh), simplex, collection);
+        append_top_dimension_cofaces(static_cast<const EdgeMesh&>(mesh), simplex, collection);
         break;
     default: log_and_throw_error("unknown mesh type in top_dimension_cofaces_tuples");
     }
 }
 
+template <typename MeshType>
+void add_top_dimension_cofaces(
+    const MeshType& mesh,
+    const Simplex& simplex,
+    SimplexCollection& collection)
+{
+    TopDimensionCofacesBuffer cofaces;
+    append_top_dimension_cofaces(mesh, simplex, cofaces);
+    const PrimitiveType top_type = mesh.top_simplex_type();
+    for (const Tuple& t : cofaces) {
+        collection.add(top_type, t);
+    }
+}
+
+} // namespace
+
+void top_dimension_cofaces(
+    const Simplex& simplex,
+    SimplexCollection& simplex_collection,
+    const bool sort_and_clean)
+{
+    const auto& m = simplex_collection.mesh();
+    top_dimension_cofaces_tuples(m, simplex, simplex_collection);
+    if (sort_and_clean) {
+        simplex_collection.sort_and_clean();
+    }
+}
+
+void top_dimension_cofaces_tuples(
+    const EdgeMesh& mesh,
+    const Simplex& simplex,
+    SimplexCollection& collection)
+{
+    add_top_dimension_cofaces(mesh, simplex, collection);
+}
+
+void top_dimension_cofaces_tuples(
+    const TriMesh& mesh,
+    const Simplex& simplex,
+    SimplexCollection& collection)
+{
+    add_top_dimension_cofaces(mesh, simplex, collection);
+}
+
+void top_dimension_cofaces_tuples(
+    const TetMesh& mesh,
+    const Simplex& simplex,
+    SimplexCollection& collection)
+{
+    add_top_dimension_cofaces(mesh, simplex, collection);
+}
+
+void top_dimension_cofaces_tuples(
+    const Mesh& mesh,
+    const Simplex& simplex,
+    SimplexCollection& collection)
+{
+    add_top_dimension_cofaces(mesh, simplex, collection);
+}
+
 
 void top_dimension_cofaces_tuples(
     const EdgeMesh& mesh,
     const Simplex& simplex,
     std::vector<Tuple>& collection)
 {
-    switch (simplex.primitive_type()) {
-    case PrimitiveType::Vertex: {
-        collection.emplace_back(simplex.tuple());
-        if (!mesh.is_boundary_vertex(simplex.tuple())) {
-            collection.emplace_back(mesh.switch_edge(simplex.tuple()));
-        }
-        break;
-    }
-    case PrimitiveType::Edge: {
-        collection.emplace_back(simplex.tuple());
-        break;
-    }
-    case PrimitiveType::Triangle: {
-        throw std::runtime_error(
-            "top_dimension_cofaces_tuples not implemented for Face in EdgeMesh");
-        break;
-    }
-    case PrimitiveType::Tetrahedron:
-    default: assert(false); break;
-    }
+    append_top_dimension_cofaces(mesh, simplex, collection);
 }
 
 void top_dimension_cofaces_tuples(
@@ -485,22 +317,7 @@ void top_dimension_cofaces_tuples(
     const Simplex& simplex,
     std::vector<Tuple>& collection)
 {
-    switch (simplex.primitive_type()) {
-    case PrimitiveType::Vertex: {
-        collection = top_dimension_cofaces_tuples_vertex(mesh, simplex.tuple());
-        break;
-    }
-    case PrimitiveType::Edge: {
-        collection = top_dimension_cofaces_tuples_edge(mesh, simplex.tuple());
-        break;
-    }
-    case PrimitiveType::Triangle: {
-        collection = top_dimension_cofaces_tuples_face(mesh, simplex.tuple());
-        break;
-    }
-    case PrimitiveType::Tetrahedron:
-    default: assert(false); break;
-    }
+    append_top_dimension_cofaces(mesh, simplex, collection);
 }
 
 void top_dimension_cofaces_tuples(
@@ -508,25 +325,7 @@ void top_dimension_cofaces_tuples(
     const Simplex& simplex,
     std::vector<Tuple>& collection)
 {
-    switch (simplex.primitive_type()) {
-    case PrimitiveType::Vertex: {
-        collection = top_dimension_cofaces_tuples_vertex(mesh, simplex.tuple());
-        break;
-    }
-    case PrimitiveType::Edge: {
-        collection = top_dimension_cofaces_tuples_edge(mesh, simplex.tuple());
-        break;
-    }
-    case PrimitiveType::Triangle: {
-        collection = top_dimension_cofaces_tuples_face(mesh, simplex.tuple());
-        break;
-    }
-    case PrimitiveType::Tetrahedron: {
-        collection = top_dimension_cofaces_tuples_tet(mesh, simplex.tuple());
-        break;
-    }
-    default: assert(false); break;
-    }
+    append_top_dimension_cofaces(mesh, simplex, collection);
 }
 
 void top_dimension_cofaces_tuples(
@@ -534,19 +333,40 @@ void top_dimension_cofaces_tuples(
     const Simplex& simplex,
     std::vector<Tuple>& tuples)
 {
-    switch (mesh.top_simplex_type()) {
-    case PrimitiveType::Triangle:
-        top_dimension_cofaces_tuples(static_cast<const TriMesh&>(mesh), simplex, tuples);
-        break;
-    case PrimitiveType::Tetrahedron:
-        top_dimension_cofaces_tuples(static_cast<const TetMesh&>(mesh), simplex, tuples);
-        break;
-    case PrimitiveType::Vertex:
-    case PrimitiveType::Edge:
-        top_dimension_cofaces_tuples(static_cast<const EdgeMesh&>(mesh), simplex, tuples);
-        break;
-    default: assert(false); //"unknown mesh type in top_dimension_cofaces_tuples"
-    }
+    append_top_dimension_cofaces(mesh, simplex, tuples);
+}
+
+
+void top_dimension_cofaces_tuples(
+    const EdgeMesh& mesh,
+    const Simplex& simplex,
+    TopDimensionCofacesBuffer& collection)
+{
+    append_top_dimension_cofaces(mesh, simplex, collection);
+}
+
+void top_dimension_cofaces_tuples(
+    const TriMesh& mesh,
+    const Simplex& simplex,
+    TopDimensionCofacesBuffer& collection)
+{
+    append_top_dimension_cofaces(mesh, simplex, collection);
+}
+
+void top_dimension_cofaces_tuples(
+    const TetMesh& mesh,
+    const Simplex& simplex,
+    TopDimensionCofacesBuffer& collection)
+{
+    append_top_dimension_cofaces(mesh, simplex, collection);
+}
+
+void top_dimension_cofaces_tuples(
+    const Mesh& mesh,
+    const Simplex& simplex,
+    TopDimensionCofacesBuffer& collection)
+{
+    append_top_dimension_cofaces(mesh, simplex, collection);
 }
 
 
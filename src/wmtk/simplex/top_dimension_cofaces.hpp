@@ -1,9 +1,19 @@
 #pragma once
 
+#include <wmtk/utils/SmallVector.hpp>
 #include "SimplexCollection.hpp"
 
 namespace wmtk::simplex {
 
+/**
+ * @brief Small buffer for top dimension cofaces.
+ *
+ * The cofaces of simplices with a typical valence fit into its inline storage, so collecting them
+ * does not touch the heap. A buffer that is reused across queries (and cleared in between) does not
+ * allocate for high valences either.
+ */
+using TopDimensionCofacesBuffer = wmtk::utils::SmallVector<Tuple, 64>;
+
 /**
  * @brief Get all top dimension cofaces of the given simplex.
  *
@@ -71,6 +81,32 @@ void top_dimension_cofaces_tuples(
     const Simplex& simplex,
     std::vector<Tuple>& collection);
 
+/**
+ * @brief The same as top_dimension_cofaces_tuples but it appends to a small buffer.
+ *
+ * Preferable in hot loops like smoothing or link checks, where the cofaces of a vertex are only
+ * iterated once.
+ */
+void top_dimension_cofaces_tuples(
+    const EdgeMesh& mesh,
+    const Simplex& simplex,
+    TopDimensionCofacesBuffer& collection);
+
+void top_dimension_cofaces_tuples(
+    const TriMesh& mesh,
+    const Simplex& simplex,
+    TopDimensionCofacesBuffer& collection);
+
+void top_dimension_cofaces_tuples(
+    const TetMesh& mesh,
+    const Simplex& simplex,
+    TopDimensionCofacesBuffer& collection);
+
+void top_dimension_cofaces_tuples(
+    const Mesh& mesh,
+    const Simplex& simplex,
+    TopDimensionCofacesBuffer& collection);
+
 /**
  * @brief Get all top dimension cofaces of the given simplex.
  *
@@ -0,0 +1,125 @@
+#include "Rational.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Logger.hpp"
+
+namespace wmtk {
+namespace {
+// first byte of every encoded value
+enum class BinaryTag : uint8_t { Double = 0, Positive = 1, Negative = 2 };
+
+void write_varint(std::vector<uint8_t>& out, uint64_t v)
+{
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+const uint8_t* read_varint(const uint8_t* data, const uint8_t* end, uint64_t& v)
+{
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (data == end) {
+            log_and_throw_error("Truncated rational encoding");
+        }
+        const uint8_t byte = *data++;
+        v |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return data;
+        }
+    }
+    log_and_throw_error("Invalid rational encoding");
+}
+
+// absolute value of z as its byte count followed by the bytes, least significant first
+void write_mpz(std::vector<uint8_t>& out, mpz_srcptr z)
+{
+    const size_t max_bytes = (mpz_sizeinbase(z, 2) + 7) / 8;
+    write_varint(out, max_bytes);
+    const size_t offset = out.size();
+    out.resize(offset + max_bytes);
+    size_t count = 0;
+    mpz_export(out.data() + offset, &count, -1, 1, 0, 0, z);
+    // zero is exported as no bytes at all
+    std::fill(out.begin() + offset + count, out.end(), uint8_t(0));
+}
+
+const uint8_t* read_mpz(const uint8_t* data, const uint8_t* end, mpz_ptr z)
+{
+    uint64_t count;
+    data = read_varint(data, end, count);
+    if (uint64_t(end - data) < count) {
+        log_and_throw_error("Truncated rational encoding");
+    }
+    mpz_import(z, count, -1, 1, 0, 0, data);
+    return data + count;
+}
+} // namespace
+
+void Rational::write_binary(std::vector<uint8_t>& out) const
+{
+    const double d = mpq_get_d(value);
+    bool is_double = std::isfinite(d);
+    if (is_double) {
+        mpq_t tmp;
+        mpq_init(tmp);
+        mpq_set_d(tmp, d);
+        // mpq_equal expects canonical values, non canonical values take the general path
+        is_double = mpq_equal(tmp, value);
+        mpq_clear(tmp);
+    }
+
+    if (is_double) {
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(double));
+        out.push_back(static_cast<uint8_t>(BinaryTag::Double));
+        for (int j = 0; j < 8; ++j) {
+            out.push_back(static_cast<uint8_t>(bits >> (8 * j)));
+        }
+        return;
+    }
+
+    const BinaryTag tag = mpq_sgn(value) < 0 ? BinaryTag::Negative : BinaryTag::Positive;
+    out.push_back(static_cast<uint8_t>(tag));
+    write_mpz(out, mpq_numref(value));
+    write_mpz(out, mpq_denref(value));
+}
+
+const uint8_t* Rational::read_binary(const uint8_t* data, const uint8_t* end)
+{
+    if (data == end) {
+        log_and_throw_error("Truncated rational encoding");
+    }
+    const BinaryTag tag = static_cast<BinaryTag>(*data++);
+    switch (tag) {
+    case BinaryTag::Double: {
+        if (end - data < 8) {
+            log_and_throw_error("Truncated rational encoding");
+        }
+        uint64_t bits = 0;
+        for (int j = 0; j < 8; ++j) {
+            bits |= uint64_t(data[j]) << (8 * j);
+        }
+        double d;
+        std::memcpy(&d, &bits, sizeof(double));
+        mpq_set_d(value, d);
+        return data + 8;
+    }
+    case BinaryTag::Positive:
+    case BinaryTag::Negative:
+        data = read_mpz(data, end, mpq_numref(value));
+        data = read_mpz(data, end, mpq_denref(value));
+        if (tag == BinaryTag::Negative) {
+            mpz_neg(mpq_numref(value), mpq_numref(value));
+        }
+        return data;
+    default: log_and_throw_error("Unknown rational encoding tag {}", int(tag));
+    }
+}
+
+} // namespace wmtk
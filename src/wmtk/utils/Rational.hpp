@@ -1,7 +1,9 @@
 #pragma once
 
 #include <gmp.h>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
 namespace wmtk {
 
@@ -188,6 +190,23 @@ public:
 
     void init_from_binary(const std::string& v) { mpq_set_str(value, v.c_str(), 2); }
 
+    /**
+     * @brief Appends a compact binary encoding of the value to out.
+     *
+     * Values that are exactly representable as a double are stored as the 8 bytes of the double,
+     * all others as the sign and the bytes of the numerator and denominator limbs. The numerator
+     * and denominator are stored as they are, so non canonical values stay non canonical.
+     */
+    void write_binary(std::vector<uint8_t>& out) const;
+    /**
+     * @brief Sets the value from an encoding written by write_binary.
+     *
+     * @param data pointer to the encoded value
+     * @param end end of the encoded buffer, used to detect truncated data
+     * @return pointer past the encoded value
+     */
+    const uint8_t* read_binary(const uint8_t* data, const uint8_t* end);
+
 private:
     mpq_t value;
 };
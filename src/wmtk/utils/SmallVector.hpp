@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace wmtk::utils {
+
+/**
+ * @brief A vector that stores up to N elements inline and only falls back to a heap allocated
+ * std::vector once more elements are added.
+ *
+ * Meant for short lived buffers of small, trivially copyable elements like tuples or ids. The
+ * inline storage is left uninitialized, only the elements that are added get constructed. Once
+ * the buffer moved to the heap it stays there until clear() is called. clear() keeps the capacity
+ * of the heap storage so a reused buffer stops allocating as well.
+ */
+template <typename T, size_t N>
+class SmallVector
+{
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "SmallVector only holds trivially copyable types");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    size_t size() const { return m_on_heap ? m_heap.size() : m_size; }
+    bool empty() const { return size() == 0; }
+    /// true as long as the elements are stored inline
+    bool is_inline() const { return !m_on_heap; }
+    static constexpr size_t inline_capacity() { return N; }
+
+    T* data() { return m_on_heap ? m_heap.data() : inline_data(); }
+    const T* data() const { return m_on_heap ? m_heap.data() : inline_data(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+
+    T& operator[](size_t index)
+    {
+        assert(index < size());
+        return data()[index];
+    }
+    const T& operator[](size_t index) const
+    {
+        assert(index < size());
+        return data()[index];
+    }
+    T& back() { return (*this)[size() - 1]; }
+    const T& back() const { return (*this)[size() - 1]; }
+
+    void push_back(const T& value)
+    {
+        if (m_on_heap) {
+            m_heap.push_back(value);
+        } else if (m_size < N) {
+            new (inline_data() + m_size++) T(value);
+        } else {
+            m_heap.reserve(2 * N);
+            m_heap.assign(inline_data(), inline_data() + m_size);
+            m_heap.push_back(value);
+            m_on_heap = true;
+        }
+    }
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        push_back(T(std::forward<Args>(args)...));
+    }
+
+    void pop_back()
+    {
+        assert(!empty());
+        if (m_on_heap) {
+            m_heap.pop_back();
+        } else {
+            --m_size;
+        }
+    }
+
+    void resize(size_t new_size)
+    {
+        if (!m_on_heap && new_size <= N) {
+            for (size_t j = m_size; j < new_size; ++j) {
+                new (inline_data() + j) T();
+            }
+            m_size = new_size;
+            return;
+        }
+        if (!m_on_heap) {
+            m_heap.assign(inline_data(), inline_data() + m_size);
+            m_on_heap = true;
+        }
+        m_heap.resize(new_size);
+    }
+
+    void clear()
+    {
+        m_size = 0;
+        m_heap.clear();
+        m_on_heap = false;
+    }
+
+private:
+    T* inline_data() { return reinterpret_cast<T*>(m_inline); }
+    const T* inline_data() const { return reinterpret_cast<const T*>(m_inline); }
+
+    alignas(T) unsigned char m_inline[N * sizeof(T)];
+    std::vector<T> m_heap;
+    size_t m_size = 0;
+    bool m_on_heap = false;
+};
+
+} // namespace wmtk::utils
@@ -0,0 +1,73 @@
+#include "orient.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "predicates.h"
+
+namespace wmtk::utils {
+
+namespace {
+int sign(double value)
+{
+    return (value > 0) - (value < 0);
+}
+} // namespace
+
+int orient3d_sign(const double* a, const double* b, const double* c, const double* d)
+{
+    // same evaluation order as orient3d so that its error analysis applies
+    const double adx = a[0] - d[0];
+    const double bdx = b[0] - d[0];
+    const double cdx = c[0] - d[0];
+    const double ady = a[1] - d[1];
+    const double bdy = b[1] - d[1];
+    const double cdy = c[1] - d[1];
+    const double adz = a[2] - d[2];
+    const double bdz = b[2] - d[2];
+    const double cdz = c[2] - d[2];
+
+    const double det = adz * (bdx * cdy - cdx * bdy) + bdz * (cdx * ady - adx * cdy) +
+                       cdz * (adx * bdy - bdx * ady);
+
+    const double maxx = std::max({std::abs(adx), std::abs(bdx), std::abs(cdx)});
+    const double maxy = std::max({std::abs(ady), std::abs(bdy), std::abs(cdy)});
+    const double maxz = std::max({std::abs(adz), std::abs(bdz), std::abs(cdz)});
+
+    // the permanent is at most 6 maxx maxy maxz, and orient3d's error bound is about 7.8e-16
+    // times the permanent. The bound itself is only reliable if it neither under nor overflows.
+    const double lower = std::min({maxx, maxy, maxz});
+    const double upper = std::max({maxx, maxy, maxz});
+    if (lower > 1e-97 && upper < 1e102) {
+        const double eps = 5.1107127829973299e-15 * maxx * maxy * maxz;
+        if (det > eps) return 1;
+        if (det < -eps) return -1;
+    }
+    return sign(orient3d(a, b, c, d));
+}
+
+int orient2d_sign(const double* a, const double* b, const double* c)
+{
+    const double acx = a[0] - c[0];
+    const double bcx = b[0] - c[0];
+    const double acy = a[1] - c[1];
+    const double bcy = b[1] - c[1];
+
+    const double det = acx * bcy - acy * bcx;
+
+    const double maxx = std::max(std::abs(acx), std::abs(bcx));
+    const double maxy = std::max(std::abs(acy), std::abs(bcy));
+
+    // the permanent is at most 2 maxx maxy, and orient2d's error bound is about 3.3e-16 times
+    // the permanent
+    const double lower = std::min(maxx, maxy);
+    const double upper = std::max(maxx, maxy);
+    if (lower > 1e-146 && upper < 1e153) {
+        const double eps = 8.8872057372592798e-16 * maxx * maxy;
+        if (det > eps) return 1;
+        if (det < -eps) return -1;
+    }
+    return sign(orient2d(a, b, c));
+}
+
+} // namespace wmtk::utils
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace wmtk::utils {
+
+/**
+ * @brief The sign of orient3d(a, b, c, d) of the exact predicates: positive if d lies below the
+ * plane through a, b, c, i.e. a, b, c appear counterclockwise when seen from above the plane.
+ *
+ * A semi-static floating point filter bounds the rounding error of the determinant by the
+ * largest coordinate differences. Only nearly degenerate inputs, or coordinates that could
+ * under/overflow the bound, fall back to the exact predicate.
+ */
+int orient3d_sign(const double* a, const double* b, const double* c, const double* d);
+
+/**
+ * @brief The sign of orient2d(a, b, c) of the exact predicates: positive if a, b, c are
+ * counterclockwise. Filtered like orient3d_sign.
+ */
+int orient2d_sign(const double* a, const double* b, const double* c);
+
+} // namespace wmtk::utils
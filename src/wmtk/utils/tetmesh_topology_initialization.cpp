@@ -1,15 +1,16 @@
 #include "tetmesh_topology_initialization.h"
 #include <algorithm>
-#include <fstream>
-#include <iostream>
 #include <vector>
 #include <wmtk/autogen/tet_mesh/autogenerated_tables.hpp>
+#include "topology_records.hpp"
 
 namespace wmtk {
 
 std::tuple<RowVectors6l, RowVectors4l, RowVectors4l, VectorXl, VectorXl, VectorXl>
 tetmesh_topology_initialization(Eigen::Ref<const RowVectors4l> T)
 {
+    using namespace utils::internal;
+
     RowVectors6l TE;
     RowVectors4l TF;
     RowVectors4l TT;
@@ -17,167 +18,95 @@ tetmesh_topology_initialization(Eigen::Ref<const RowVectors4l> T)
     VectorXl ET;
     VectorXl VT;
 
-    // First pass is identifying faces, and filling VT
-    std::vector<std::vector<int64_t>> TTT;
-
-    char iv0 = 0;
-    char iv1 = 1;
-    char iv2 = 2;
-    char it = 3;
-    char ii = 4;
+    constexpr int64_t it = 3;
+    constexpr int64_t ii = 4;
 
+    const int64_t vertex_count = T.maxCoeff() + 1;
+    const int64_t tet_count = T.rows();
 
-    int64_t vertex_count = T.maxCoeff() + 1;
+    // VT
+    VT = last_incident_top_simplex(T, vertex_count);
 
     // Build a table for finding Faces and populate the corresponding
     // topology relations
     {
-        TTT.resize(T.rows() * 4);
-        for (int64_t t = 0; t < T.rows(); ++t) {
-            for (int64_t i = 0; i < 4; ++i) {
-                // v1 v2 v3 f ei
+        // v1 v2 v3 t fi
+        const std::vector<Record<5>> TTT =
+            sorted_records<5>(tet_count, 4, [&](int64_t t, int64_t i, Record<5>& r) {
                 int64_t x = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_faces[i][0]));
                 int64_t y = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_faces[i][1]));
                 int64_t z = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_faces[i][2]));
                 if (x > y) std::swap(x, y);
                 if (y > z) std::swap(y, z);
                 if (x > y) std::swap(x, y);
+                r = {{x, y, z, t, i}};
+            });
 
-                std::vector<int64_t> r(5);
-                r[iv0] = x;
-                r[iv1] = y;
-                r[iv2] = z;
-                r[it] = t;
-                r[ii] = i;
-                TTT[t * 4 + i] = r;
-            }
-        }
-        std::sort(TTT.begin(), TTT.end());
-
-        // std::ofstream file("TTT_F_debug.txt");
-        // for (const auto& row : TTT) {
-        //     for (const auto& element : row) {
-        //         file << element << " ";
-        //     }
-        //     file << std::endl;
-        // }
-        // file.close();
-
-        // VT
-        VT.resize(vertex_count, 1);
-        for (int64_t i = 0; i < T.rows(); ++i) {
-            for (int64_t j = 0; j < T.cols(); ++j) {
-                VT[T(i, j)] = i;
-            }
-        }
+        // an interior face is a pair of consecutive records with the same vertices, a boundary
+        // face a single one
+        const std::vector<int64_t> ids = record_ids<3>(TTT, true);
+        const int64_t n = TTT.size();
+        const int64_t face_count = n == 0 ? 0 : ids.back() + 1;
 
         // Compute TF, TT, and FT
-        TF.resize(T.rows(), 4);
-        TT.resize(T.rows(), 4);
-        std::vector<int64_t> FT_temp;
-
-        // iterate over TTT to find faces
-        // for every entry check if the next is the same, and update the connectivity accordingly
-
-        for (int64_t i = 0; i < TTT.size(); ++i) {
-            if ((i == TTT.size() - 1) || (TTT[i][0] != TTT[i + 1][0]) ||
-                (TTT[i][1] != TTT[i + 1][1]) || (TTT[i][2] != TTT[i + 1][2])) {
-                // If the next tuple is empty, then this is a boundary face
-                FT_temp.push_back(TTT[i][it]);
-
-                TT(TTT[i][it], TTT[i][ii]) = -1;
-                TF(TTT[i][it], TTT[i][ii]) = FT_temp.size() - 1;
-            } else {
-                // this is an internal face, update both sides
-                // If the next tuple is empty, then this is a boundary face
-
-                FT_temp.push_back(TTT[i][it]);
-
-                TT(TTT[i][it], TTT[i][ii]) = TTT[i + 1][it];
-                TF(TTT[i][it], TTT[i][ii]) = FT_temp.size() - 1;
-
-                TT(TTT[i + 1][it], TTT[i + 1][ii]) = TTT[i][it];
-                TF(TTT[i + 1][it], TTT[i + 1][ii]) = FT_temp.size() - 1;
-
-                ++i; // skip the other entry
-            }
-        }
-
-        // copy FT
-        FT.resize(FT_temp.size());
-        for (int64_t i = 0; i < FT_temp.size(); ++i) FT(i) = FT_temp[i];
+        TF.resize(tet_count, 4);
+        TT.resize(tet_count, 4);
+        FT.resize(face_count);
+        tbb::parallel_for(
+            tbb::blocked_range<int64_t>(0, n),
+            [&](const tbb::blocked_range<int64_t>& range) {
+                for (int64_t j = range.begin(); j < range.end(); ++j) {
+                    const Record<5>& r = TTT[j];
+                    const int64_t f = ids[j];
+                    TF(r[it], r[ii]) = f;
+                    if (j + 1 < n && ids[j + 1] == f) {
+                        TT(r[it], r[ii]) = TTT[j + 1][it];
+                    } else if (j > 0 && ids[j - 1] == f) {
+                        TT(r[it], r[ii]) = TTT[j - 1][it];
+                    } else {
+                        TT(r[it], r[ii]) = -1;
+                    }
+                    if (j == 0 || ids[j - 1] != f) {
+                        FT(f) = r[it];
+                    }
+                }
+            });
     }
 
     // Build a table for finding edges and populate the corresponding
     // topology relations
     {
-        TTT.resize(T.rows() * 6);
-        for (int64_t t = 0; t < T.rows(); ++t) {
-            for (int64_t i = 0; i < 6; ++i) {
-                // v1 v2 f ei
+        // v1 v2 t ei
+        constexpr int64_t et = 2;
+        constexpr int64_t ei = 3;
+        const std::vector<Record<4>> TTT =
+            sorted_records<4>(tet_count, 6, [&](int64_t t, int64_t i, Record<4>& r) {
                 int64_t x = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_edges[i][0]));
                 int64_t y = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_edges[i][1]));
                 if (x > y) std::swap(x, y);
+                r = {{x, y, t, i}};
+            });
 
-                std::vector<int64_t> r(5);
-                r[iv0] = x;
-                r[iv1] = y;
-                r[iv2] = 0; // unused
-                r[it] = t;
-                r[ii] = i;
-                TTT[t * 6 + i] = r;
-            }
-        }
-        std::sort(TTT.begin(), TTT.end());
-
-        // std::ofstream file("TTT_E_debug.txt");
-        // for (const auto& row : TTT) {
-        //     for (const auto& element : row) {
-        //         file << element << " ";
-        //     }
-        //     file << std::endl;
-        // }
-        // file.close();
-
+        // all the copies of an edge get the same id
+        const std::vector<int64_t> ids = record_ids<2>(TTT, false);
+        const int64_t n = TTT.size();
+        const int64_t edge_count = n == 0 ? 0 : ids.back() + 1;
 
         // Compute TE, ET
-        TE.resize(T.rows(), 6);
-        std::vector<int64_t> ET_temp;
-
-
-        // iterate over TTT to find edges
-        // for every entry check if the next is the same, and update the connectivity accordingly
-        for (int64_t i = 0; i < TTT.size(); ++i) {
-            if ((i == TTT.size() - 1) || (TTT[i][0] != TTT[i + 1][0]) ||
-                (TTT[i][1] != TTT[i + 1][1])) {
-                // new edge found
-                ET_temp.push_back(TTT[i][it]);
-
-                // update first copy
-                TE(TTT[i][it], TTT[i][ii]) = ET_temp.size() - 1;
-            } else {
-                // new edge found
-                ET_temp.push_back(TTT[i][it]);
-
-                // update first copy
-                TE(TTT[i][it], TTT[i][ii]) = ET_temp.size() - 1;
-
-                // loop over all the copies
-                int64_t j = 1;
-                while ((i + j < TTT.size()) && (TTT[i][0] == TTT[i + j][0]) &&
-                       (TTT[i][1] == TTT[i + j][1])) {
-                    TE(TTT[i + j][it], TTT[i + j][ii]) = ET_temp.size() - 1;
-                    ++j;
+        TE.resize(tet_count, 6);
+        ET.resize(edge_count);
+        tbb::parallel_for(
+            tbb::blocked_range<int64_t>(0, n),
+            [&](const tbb::blocked_range<int64_t>& range) {
+                for (int64_t j = range.begin(); j < range.end(); ++j) {
+                    const Record<4>& r = TTT[j];
+                    const int64_t e = ids[j];
+                    TE(r[et], r[ei]) = e;
+                    if (j == 0 || ids[j - 1] != e) {
+                        ET(e) = r[et];
+                    }
                 }
-                assert(j >= 2);
-
-                i = i + j - 1; // skip the visited entries
-            }
-        }
-
-        // copy ET
-        ET.resize(ET_temp.size());
-        for (int64_t i = 0; i < ET_temp.size(); ++i) ET(i) = ET_temp[i];
+            });
     }
 
     return {TE, TF, TT, VT, ET, FT};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include <wmtk/Types.hpp>
+
+namespace wmtk::utils::internal {
+
+/**
+ * @brief Helpers of the tri and tet mesh topology initialization.
+ *
+ * A record of length N describes a face of a top simplex: its K sorted vertex ids, the top simplex
+ * id and the local index of the face, so records are unique and their lexicographic order does not
+ * depend on how they were sorted.
+ */
+template <size_t N>
+using Record = std::array<int64_t, N>;
+
+/**
+ * @brief Fills records[faces_per_top * t + i] with make(t, i, record) in parallel and sorts them.
+ */
+template <size_t N, typename Make>
+std::vector<Record<N>> sorted_records(int64_t top_count, int64_t faces_per_top, Make&& make)
+{
+    std::vector<Record<N>> records(top_count * faces_per_top);
+    tbb::parallel_for(
+        tbb::blocked_range<int64_t>(0, top_count),
+        [&](const tbb::blocked_range<int64_t>& range) {
+            for (int64_t t = range.begin(); t < range.end(); ++t) {
+                for (int64_t i = 0; i < faces_per_top; ++i) {
+                    make(t, i, records[faces_per_top * t + i]);
+                }
+            }
+        });
+    tbb::parallel_sort(records.begin(), records.end());
+    return records;
+}
+
+/// in place inclusive scan of values with the associative op
+template <typename Op>
+void inclusive_scan(std::vector<int64_t>& values, int64_t identity, Op op)
+{
+    tbb::parallel_scan(
+        tbb::blocked_range<size_t>(0, values.size()),
+        identity,
+        [&](const tbb::blocked_range<size_t>& range, int64_t sum, bool is_final) {
+            for (size_t j = range.begin(); j < range.end(); ++j) {
+                sum = op(sum, values[j]);
+                if (is_final) values[j] = sum;
+            }
+            return sum;
+        },
+        op);
+}
+
+/**
+ * @brief Numbers the simplices described by the sorted records, in the order of their keys, the
+ * first K entries.
+ *
+ * Without pairing all records of a key get the same id. With pairing consecutive records of a key
+ * are matched two by two, each pair (or single leftover) being one simplex, as the sequential scan
+ * for the manifold faces did.
+ *
+ * @return the id of the simplex of every record
+ */
+template <size_t K, size_t N>
+std::vector<int64_t> record_ids(const std::vector<Record<N>>& records, bool pairing)
+{
+    const int64_t n = records.size();
+    auto is_new_key = [&](int64_t j) {
+        return j == 0 || !std::equal(
+                              records[j].begin(),
+                              records[j].begin() + K,
+                              records[j - 1].begin());
+    };
+    auto parallel_fill = [n](auto&& f) {
+        tbb::parallel_for(
+            tbb::blocked_range<int64_t>(0, n),
+            [&](const tbb::blocked_range<int64_t>& range) {
+                for (int64_t j = range.begin(); j < range.end(); ++j) f(j);
+            });
+    };
+
+    std::vector<int64_t> ids(n);
+    if (pairing) {
+        // the rank of a record among the ones of its key, through the start of its key
+        parallel_fill([&](int64_t j) { ids[j] = is_new_key(j) ? j : 0; });
+        inclusive_scan(ids, 0, [](int64_t a, int64_t b) { return std::max(a, b); });
+        parallel_fill([&](int64_t j) { ids[j] = (j - ids[j]) % 2 == 0 ? 1 : 0; });
+    } else {
+        parallel_fill([&](int64_t j) { ids[j] = is_new_key(j) ? 1 : 0; });
+    }
+    inclusive_scan(ids, 0, std::plus<int64_t>());
+    parallel_fill([&](int64_t j) { --ids[j]; });
+    return ids;
+}
+
+/**
+ * @brief For every vertex the largest id of the top simplices containing it, -1 if there is none.
+ */
+template <typename Derived>
+VectorXl last_incident_top_simplex(const Eigen::MatrixBase<Derived>& S, int64_t vertex_count)
+{
+    std::vector<std::atomic<int64_t>> last(vertex_count);
+    tbb::parallel_for(int64_t(0), vertex_count, [&](int64_t v) { last[v].store(-1); });
+    tbb::parallel_for(
+        tbb::blocked_range<int64_t>(0, S.rows()),
+        [&](const tbb::blocked_range<int64_t>& range) {
+            for (int64_t s = range.begin(); s < range.end(); ++s) {
+                for (int64_t j = 0; j < S.cols(); ++j) {
+                    std::atomic<int64_t>& l = last[S(s, j)];
+                    int64_t current = l.load();
+                    while (current < s && !l.compare_exchange_weak(current, s)) {
+                    }
+                }
+            }
+        });
+
+    VectorXl res(vertex_count);
+    tbb::parallel_for(int64_t(0), vertex_count, [&](int64_t v) { res[v] = last[v].load(); });
+    return res;
+}
+
+} // namespace wmtk::utils::internal
@@ -0,0 +1,131 @@
+#include <map>
+#include <memory_resource>
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+#include <wmtk/attribute/AttributeCacheData.hpp>
+#include <wmtk/attribute/internal/FlatCacheStorage.hpp>
+#include <wmtk/utils/Logger.hpp>
+
+#include <polysolve/Utils.hpp>
+
+using namespace wmtk;
+using namespace wmtk::attribute;
+
+TEST_CASE("flat_cache_storage", "[attributes][cache]")
+{
+    internal::FlatCacheStorage<double> storage;
+    const int64_t dim = 3;
+
+    // enough entries to go through the linear scan and several table rebuilds
+    for (int64_t round = 0; round < 2; ++round) {
+        for (int64_t j = 0; j < 1000; ++j) {
+            const int64_t index = 7 * j + 3;
+            auto [ptr, inserted] = storage.try_emplace(index, dim);
+            REQUIRE(inserted);
+            for (int64_t k = 0; k < dim; ++k) {
+                ptr[k] = index + k;
+            }
+            // the first value cached for an index is kept
+            auto [ptr2, inserted2] = storage.try_emplace(index, dim);
+            CHECK_FALSE(inserted2);
+            CHECK(ptr2[0] == index);
+        }
+        CHECK(storage.size() == 1000);
+        CHECK(storage.dimension() == dim);
+
+        for (int64_t j = 0; j < 1000; ++j) {
+            const int64_t index = 7 * j + 3;
+            const double* ptr = storage.find(index);
+            REQUIRE(ptr != nullptr);
+            CHECK(ptr[2] == index + 2);
+            CHECK(storage.find(index + 1) == nullptr);
+        }
+
+        int64_t count = 0;
+        int64_t last = -1;
+        storage.for_each([&](int64_t index, const double* value) {
+            // insertion order
+            CHECK(index > last);
+            CHECK(value[1] == index + 1);
+            last = index;
+            ++count;
+        });
+        CHECK(count == 1000);
+
+        storage.clear();
+        CHECK(storage.size() == 0);
+        CHECK(storage.find(3) == nullptr);
+    }
+}
+
+TEST_CASE("attribute_cache_performance", "[attributes][cache][performance][.]")
+{
+    // mimics what an operation caches: a few dozen indices per scope, written once and rolled
+    // back or merged afterwards
+    const int64_t n_scopes = 200000;
+    const int64_t n_writes = 40;
+    const int64_t dim = 3;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> dist(0, 1000000);
+    std::vector<int64_t> indices(n_scopes * n_writes);
+    for (int64_t& i : indices) {
+        i = dist(gen);
+    }
+    const Eigen::Vector3d value(1, 2, 3);
+
+    double sum = 0;
+    {
+        POLYSOLVE_SCOPED_STOPWATCH("std::map cache", logger());
+        for (int64_t s = 0; s < n_scopes; ++s) {
+            std::map<int64_t, AttributeCacheData<double>> data;
+            for (int64_t w = 0; w < n_writes; ++w) {
+                auto [it, inserted] =
+                    data.try_emplace(indices[s * n_writes + w], AttributeCacheData<double>{});
+                if (inserted) {
+                    it->second.data = value;
+                }
+            }
+            for (const auto& [index, d] : data) {
+                sum += d.data[0];
+            }
+        }
+    }
+    {
+        POLYSOLVE_SCOPED_STOPWATCH("monotonic std::map cache", logger());
+        using Alloc = std::pmr::polymorphic_allocator<
+            std::pair<const int64_t, AttributeCacheData<double>>>;
+        for (int64_t s = 0; s < n_scopes; ++s) {
+            std::vector<std::int8_t> buffer(
+                32 * sizeof(std::pair<const int64_t, AttributeCacheData<double>>));
+            std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size());
+            std::map<int64_t, AttributeCacheData<double>, std::less<int64_t>, Alloc> data{
+                Alloc{&resource}};
+            for (int64_t w = 0; w < n_writes; ++w) {
+                auto [it, inserted] =
+                    data.try_emplace(indices[s * n_writes + w], AttributeCacheData<double>{});
+                if (inserted) {
+                    it->second.data = value;
+                }
+            }
+            for (const auto& [index, d] : data) {
+                sum += d.data[0];
+            }
+        }
+    }
+    {
+        POLYSOLVE_SCOPED_STOPWATCH("flat cache", logger());
+        for (int64_t s = 0; s < n_scopes; ++s) {
+            internal::FlatCacheStorage<double> data;
+            for (int64_t w = 0; w < n_writes; ++w) {
+                auto [ptr, inserted] = data.try_emplace(indices[s * n_writes + w], dim);
+                if (inserted) {
+                    std::copy(value.data(), value.data() + dim, ptr);
+                }
+            }
+            data.for_each([&](int64_t, const double* d) { sum += d[0]; });
+        }
+    }
+    logger().info("checksum {}", sum);
+}
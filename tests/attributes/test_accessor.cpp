@@ -1,4 +1,6 @@
+#include <atomic>
 #include <numeric>
+#include <thread>
 
 #include <catch2/catch_test_macros.hpp>
 #include <wmtk/attribute/Attribute.hpp>
@@ -345,6 +347,70 @@ TEST_CASE("test_accessor_caching_scope_fails_success", "[accessor]")
     check(m, double_acc, true);
 }
 
+TEST_CASE("test_accessor_caching_scope_per_thread", "[accessor]")
+{
+    const int64_t n_threads = 4;
+    const int64_t block = 10;
+    DEBUG_PointMesh m(n_threads * block);
+    auto int64_t_handle =
+        m.register_attribute_typed<int64_t>("int64_t", wmtk::PrimitiveType::Vertex, 1);
+    auto double_handle =
+        m.register_attribute_typed<double>("double", wmtk::PrimitiveType::Vertex, 3);
+    // the accessors are created here and shared by all threads
+    auto int64_t_acc = m.create_accessor(int64_t_handle);
+    auto double_acc = m.create_accessor(double_handle);
+    populate(m, int64_t_acc, true);
+    populate(m, double_acc, true);
+
+    const auto vertices = m.get_all(wmtk::PrimitiveType::Vertex);
+    std::atomic<int64_t> opened = 0;
+    std::atomic<int64_t> errors = 0;
+
+    auto run = [&](int64_t thread_id) {
+        auto scope = m.create_scope();
+        if (int64_t_acc.stack_depth() != 1 || double_acc.stack_depth() != 1) {
+            ++errors;
+        }
+        for (int64_t j = thread_id * block; j < (thread_id + 1) * block; ++j) {
+            int64_t_acc.scalar_attribute(vertices[j]) = j;
+            double_acc.vector_attribute(vertices[j]).setConstant(j);
+        }
+
+        // make sure every scope is open at the same time
+        ++opened;
+        while (opened < n_threads) {
+            std::this_thread::yield();
+        }
+
+        // odd threads roll back, even threads commit
+        if (thread_id % 2 == 1) {
+            scope.mark_failed();
+        }
+    };
+
+    m.set_accessed_concurrently(true);
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < n_threads; ++t) {
+        threads.emplace_back(run, t);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    m.set_accessed_concurrently(false);
+
+    CHECK(errors == 0);
+    // none of the worker scopes leaked into this thread
+    CHECK(int64_t_acc.stack_depth() == 0);
+    CHECK(double_acc.stack_depth() == 0);
+
+    for (int64_t j = 0; j < n_threads * block; ++j) {
+        const bool committed = (j / block) % 2 == 0;
+        const int64_t expected = committed ? j : 0;
+        CHECK(int64_t_acc.const_scalar_attribute(vertices[j]) == expected);
+        CHECK((double_acc.const_vector_attribute(vertices[j]).array() == expected).all());
+    }
+}
+
 TEST_CASE("accessor_parent_scope_access", "[accessor]")
 {
     using namespace wmtk;
@@ -423,6 +489,98 @@ TEST_CASE("accessor_parent_scope_access", "[accessor]")
     }
 }
 
+TEST_CASE("accessor_lazy_scopes", "[accessor]")
+{
+    using namespace wmtk;
+
+    int64_t size = 3;
+    DEBUG_PointMesh m(size);
+    auto int64_t_handle =
+        m.register_attribute_typed<int64_t>("int64_t", wmtk::PrimitiveType::Vertex, 1, 0);
+    auto int64_t_acc = m.create_accessor(int64_t_handle);
+
+    // attributes that are never written should not get a scope
+    std::vector<attribute::TypedAttributeHandle<double>> unused_handles;
+    for (int64_t j = 0; j < 20; ++j) {
+        unused_handles.emplace_back(m.register_attribute_typed<double>(
+            "unused_" + std::to_string(j),
+            wmtk::PrimitiveType::Vertex,
+            3,
+            0));
+    }
+    auto unused_acc = m.create_accessor(unused_handles.front());
+
+    const auto& stack = int64_t_acc.attribute().get_local_scope_stack();
+    const auto& unused_stack = unused_acc.attribute().get_local_scope_stack();
+
+    const std::vector<Tuple> vertices = m.get_all(PrimitiveType::Vertex);
+    auto check_values = [&](int64_t value) {
+        for (const Tuple& t : vertices) {
+            CHECK(int64_t_acc.const_scalar_attribute(t) == value);
+        }
+    };
+
+    {
+        auto scope = m.create_scope();
+        CHECK(stack.size() == 1);
+        CHECK(stack.materialized_size() == 0);
+
+        for (const Tuple& t : vertices) {
+            int64_t_acc.scalar_attribute(t) = 1;
+        }
+        CHECK(stack.materialized_size() == 1);
+
+        {
+            // a scope that does not write anything
+            auto pass_through_scope = m.create_scope();
+            {
+                auto inner_scope = m.create_scope();
+                CHECK(stack.size() == 3);
+                CHECK(stack.materialized_size() == 1);
+
+                for (const Tuple& t : vertices) {
+                    int64_t_acc.scalar_attribute(t) = 3;
+                }
+                CHECK(stack.materialized_size() == 2);
+
+                m.parent_scope([&]() {
+                    check_values(1);
+                    m.parent_scope([&]() {
+                        check_values(1);
+                        m.parent_scope([&]() { check_values(0); });
+                    });
+                });
+            }
+            // the inner changes were handed to the pass through scope
+            CHECK(stack.materialized_size() == 2);
+            check_values(3);
+            m.parent_scope([&]() { check_values(1); });
+
+            pass_through_scope.mark_failed();
+            CHECK(stack.materialized_size() == 1);
+        }
+        check_values(1);
+
+        {
+            auto failing_scope = m.create_scope();
+            for (const Tuple& t : vertices) {
+                int64_t_acc.scalar_attribute(t) = 4;
+            }
+            failing_scope.mark_failed();
+            check_values(1);
+        }
+        CHECK(stack.materialized_size() == 1);
+
+        CHECK(unused_stack.size() == 1);
+        CHECK(unused_stack.materialized_size() == 0);
+
+        scope.mark_failed();
+    }
+    check_values(0);
+    CHECK(stack.size() == 0);
+    CHECK(stack.materialized_size() == 0);
+}
+
 TEST_CASE("attribute_clear", "[attributes]")
 {
     wmtk::TriMesh mold = single_equilateral_triangle(); // 0xa <- 0xa
@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>
+
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/TriMesh.hpp>
+#include <wmtk/function/LocalNeighborsSumFunction.hpp>
+#include <wmtk/function/simplex/AMIPS.hpp>
+#include <wmtk/function/simplex/TriangleAMIPS.hpp>
+#include <wmtk/simplex/top_dimension_cofaces.hpp>
+
+#include "grids.hpp"
+
+using namespace wmtk;
+
+namespace {
+
+enum class Evaluation { Value, Gradient, Hessian };
+
+// evaluates the function on every top simplex of the grid wrt its first vertex
+void evaluate_all(
+    benchmark::State& state,
+    const Mesh& m,
+    const function::PerSimplexFunction& f,
+    Evaluation evaluation)
+{
+    const PrimitiveType top_type = m.top_simplex_type();
+    const std::vector<Tuple> cells = m.get_all(top_type);
+
+    for (auto _ : state) {
+        for (const Tuple& t : cells) {
+            const simplex::Simplex cell(top_type, t);
+            const simplex::Simplex vertex = simplex::Simplex::vertex(t);
+            switch (evaluation) {
+            case Evaluation::Value: benchmark::DoNotOptimize(f.get_value(cell)); break;
+            case Evaluation::Gradient:
+                benchmark::DoNotOptimize(f.get_gradient(cell, vertex));
+                break;
+            case Evaluation::Hessian: benchmark::DoNotOptimize(f.get_hessian(cell, vertex)); break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * cells.size());
+}
+
+void BM_AMIPS_2D(benchmark::State& state, Evaluation evaluation)
+{
+    const auto mesh = benchmarks::tri_grid(state.range(0));
+    const auto pos_handle =
+        mesh->get_attribute_handle<double>(benchmarks::position_name, PrimitiveType::Vertex);
+    const function::AMIPS amips(*mesh, pos_handle);
+    evaluate_all(state, *mesh, amips, evaluation);
+}
+BENCHMARK_CAPTURE(BM_AMIPS_2D, value, Evaluation::Value)->Arg(64);
+BENCHMARK_CAPTURE(BM_AMIPS_2D, gradient, Evaluation::Gradient)->Arg(64);
+BENCHMARK_CAPTURE(BM_AMIPS_2D, hessian, Evaluation::Hessian)->Arg(64);
+
+void BM_AMIPS_3D(benchmark::State& state, Evaluation evaluation)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    const auto pos_handle =
+        mesh->get_attribute_handle<double>(benchmarks::position_name, PrimitiveType::Vertex);
+    const function::AMIPS amips(*mesh, pos_handle);
+    evaluate_all(state, *mesh, amips, evaluation);
+}
+BENCHMARK_CAPTURE(BM_AMIPS_3D, value, Evaluation::Value)->Arg(12);
+BENCHMARK_CAPTURE(BM_AMIPS_3D, gradient, Evaluation::Gradient)->Arg(12);
+BENCHMARK_CAPTURE(BM_AMIPS_3D, hessian, Evaluation::Hessian)->Arg(12);
+
+// the sums over the tets around every vertex, what a smoothing step evaluates
+void BM_AMIPS_3D_one_ring(benchmark::State& state, Evaluation evaluation)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    const auto pos_handle =
+        mesh->get_attribute_handle<double>(benchmarks::position_name, PrimitiveType::Vertex);
+    function::AMIPS amips(*mesh, pos_handle);
+    const function::LocalNeighborsSumFunction f(*mesh, pos_handle, amips);
+    const std::vector<Tuple> vertices = mesh->get_all(PrimitiveType::Vertex);
+
+    for (auto _ : state) {
+        for (const Tuple& t : vertices) {
+            const simplex::Simplex vertex = simplex::Simplex::vertex(t);
+            switch (evaluation) {
+            case Evaluation::Value: benchmark::DoNotOptimize(f.get_value(vertex)); break;
+            case Evaluation::Gradient: benchmark::DoNotOptimize(f.get_gradient(vertex)); break;
+            case Evaluation::Hessian: benchmark::DoNotOptimize(f.get_hessian(vertex)); break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * vertices.size());
+}
+BENCHMARK_CAPTURE(BM_AMIPS_3D_one_ring, value, Evaluation::Value)->Arg(12);
+BENCHMARK_CAPTURE(BM_AMIPS_3D_one_ring, gradient, Evaluation::Gradient)->Arg(12);
+BENCHMARK_CAPTURE(BM_AMIPS_3D_one_ring, hessian, Evaluation::Hessian)->Arg(12);
+
+// the same sums one tet at a time, what LocalNeighborsSumFunction did before the lane groups
+void BM_AMIPS_3D_one_ring_per_tet(benchmark::State& state, Evaluation evaluation)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    const auto pos_handle =
+        mesh->get_attribute_handle<double>(benchmarks::position_name, PrimitiveType::Vertex);
+    const function::AMIPS amips(*mesh, pos_handle);
+    const function::PerSimplexFunction& f = amips;
+    const std::vector<Tuple> vertices = mesh->get_all(PrimitiveType::Vertex);
+    std::vector<std::vector<simplex::Simplex>> rings;
+    for (const Tuple& t : vertices) {
+        rings.emplace_back();
+        for (const Tuple& tet :
+             simplex::top_dimension_cofaces_tuples(*mesh, simplex::Simplex::vertex(t))) {
+            rings.back().emplace_back(PrimitiveType::Tetrahedron, tet);
+        }
+    }
+
+    for (auto _ : state) {
+        for (size_t j = 0; j < vertices.size(); ++j) {
+            const simplex::Simplex vertex = simplex::Simplex::vertex(vertices[j]);
+            Eigen::Vector3d g = Eigen::Vector3d::Zero();
+            Eigen::Matrix3d h = Eigen::Matrix3d::Zero();
+            switch (evaluation) {
+            case Evaluation::Value:
+                benchmark::DoNotOptimize(f.PerSimplexFunction::get_value_sum(rings[j], vertex));
+                break;
+            case Evaluation::Gradient:
+                f.PerSimplexFunction::add_gradient_sum(rings[j], vertex, g);
+                benchmark::DoNotOptimize(g);
+                break;
+            case Evaluation::Hessian:
+                f.PerSimplexFunction::add_hessian_sum(rings[j], vertex, h);
+                benchmark::DoNotOptimize(h);
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * vertices.size());
+}
+BENCHMARK_CAPTURE(BM_AMIPS_3D_one_ring_per_tet, value, Evaluation::Value)->Arg(12);
+BENCHMARK_CAPTURE(BM_AMIPS_3D_one_ring_per_tet, gradient, Evaluation::Gradient)->Arg(12);
+BENCHMARK_CAPTURE(BM_AMIPS_3D_one_ring_per_tet, hessian, Evaluation::Hessian)->Arg(12);
+
+// the closed form version of the 2D energy
+void BM_TriangleAMIPS(benchmark::State& state, Evaluation evaluation)
+{
+    const auto mesh = benchmarks::tri_grid(state.range(0));
+    const auto pos_handle =
+        mesh->get_attribute_handle<double>(benchmarks::position_name, PrimitiveType::Vertex);
+    const function::TriangleAMIPS amips(*mesh, pos_handle);
+    evaluate_all(state, *mesh, amips, evaluation);
+}
+BENCHMARK_CAPTURE(BM_TriangleAMIPS, value, Evaluation::Value)->Arg(64);
+BENCHMARK_CAPTURE(BM_TriangleAMIPS, gradient, Evaluation::Gradient)->Arg(64);
+BENCHMARK_CAPTURE(BM_TriangleAMIPS, hessian, Evaluation::Hessian)->Arg(64);
+
+// the autodiff encoding TriangleAMIPS keeps for validation, as a reference
+void BM_TriangleAMIPS_autodiff(benchmark::State& state, Evaluation evaluation)
+{
+    const auto mesh = benchmarks::tri_grid(state.range(0));
+    const auto pos_handle =
+        mesh->get_attribute_handle<double>(benchmarks::position_name, PrimitiveType::Vertex);
+    const function::TriangleAMIPS amips(*mesh, pos_handle);
+    const function::PerSimplexAutodiffFunction& f = amips;
+    const std::vector<Tuple> cells = mesh->get_all(PrimitiveType::Triangle);
+
+    for (auto _ : state) {
+        for (const Tuple& t : cells) {
+            const simplex::Simplex cell(PrimitiveType::Triangle, t);
+            const simplex::Simplex vertex = simplex::Simplex::vertex(t);
+            switch (evaluation) {
+            case Evaluation::Value:
+                benchmark::DoNotOptimize(f.PerSimplexAutodiffFunction::get_value(cell));
+                break;
+            case Evaluation::Gradient:
+                benchmark::DoNotOptimize(f.PerSimplexAutodiffFunction::get_gradient(cell, vertex));
+                break;
+            case Evaluation::Hessian:
+                benchmark::DoNotOptimize(f.PerSimplexAutodiffFunction::get_hessian(cell, vertex));
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * cells.size());
+}
+BENCHMARK_CAPTURE(BM_TriangleAMIPS_autodiff, value, Evaluation::Value)->Arg(64);
+BENCHMARK_CAPTURE(BM_TriangleAMIPS_autodiff, gradient, Evaluation::Gradient)->Arg(64);
+BENCHMARK_CAPTURE(BM_TriangleAMIPS_autodiff, hessian, Evaluation::Hessian)->Arg(64);
+
+} // namespace
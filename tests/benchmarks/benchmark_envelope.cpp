@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+
+#include <wmtk/TriMesh.hpp>
+#include <wmtk/envelope/EnvelopeIndex.hpp>
+#include <wmtk/invariants/EnvelopeInvariant.hpp>
+#include <wmtk/io/MeshReader.hpp>
+#include <wmtk/simplex/faces_single_dimension.hpp>
+#include <wmtk/simplex/top_dimension_cofaces.hpp>
+
+#include <fastenvelope/FastEnvelope.h>
+
+#include <cmath>
+#include <filesystem>
+#include <limits>
+
+#include "grids.hpp"
+
+using namespace wmtk;
+
+namespace {
+
+constexpr PrimitiveType PV = PrimitiveType::Vertex;
+constexpr PrimitiveType PF = PrimitiveType::Triangle;
+
+// a wavy surface over the grid, stands in for the surfaces wildmeshing keeps inside an envelope
+attribute::MeshAttributeHandle add_surface_position(TriMesh& m)
+{
+    const auto grid_handle = m.get_attribute_handle<double>(benchmarks::position_name, PV);
+    const auto handle = m.register_attribute<double>("surface_position", PV, 3);
+    const attribute::Accessor<double> grid = m.create_const_accessor<double>(grid_handle);
+    attribute::Accessor<double> surface = m.create_accessor<double>(handle);
+    for (const Tuple& v : m.get_all(PV)) {
+        const Eigen::Vector2d p = grid.const_vector_attribute(v);
+        surface.vector_attribute(v) << p[0], p[1], std::sin(0.3 * p[0]) * std::cos(0.3 * p[1]);
+    }
+    return handle;
+}
+
+// the triangles around every vertex, what the invariant sees after smoothing a vertex
+std::vector<std::vector<Tuple>> vertex_rings(const TriMesh& m)
+{
+    std::vector<std::vector<Tuple>> rings;
+    for (const Tuple& v : m.get_all(PV)) {
+        rings.emplace_back(simplex::top_dimension_cofaces_tuples(m, simplex::Simplex::vertex(v)));
+    }
+    return rings;
+}
+
+// the data mesh with an envelope of 1e-3 of its bounding box diagonal, like wildmeshing uses
+const std::filesystem::path data_mesh = std::filesystem::path(WMTK_DATA_DIR) / "bumpyDice.msh";
+
+std::shared_ptr<TriMesh> read_data_mesh()
+{
+    return std::static_pointer_cast<TriMesh>(read_mesh(data_mesh));
+}
+
+double data_envelope_size(const TriMesh& m, const attribute::MeshAttributeHandle& handle)
+{
+    const attribute::Accessor<double> accessor = m.create_const_accessor<double>(handle);
+    Eigen::Vector3d min = Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+    Eigen::Vector3d max = -min;
+    for (const Tuple& v : m.get_all(PV)) {
+        min = min.cwiseMin(accessor.const_vector_attribute(v));
+        max = max.cwiseMax(accessor.const_vector_attribute(v));
+    }
+    return 1e-3 * (max - min).norm();
+}
+
+// the per triangle path the invariant used before, as a reference
+void per_triangle(
+    benchmark::State& state,
+    const TriMesh& mesh,
+    const attribute::MeshAttributeHandle& handle,
+    double envelope_size)
+{
+    const auto index = std::make_shared<envelope::EnvelopeIndex>(handle);
+    const auto fast_envelope = index->fast_envelope(envelope_size);
+    const attribute::Accessor<double> accessor = mesh.create_const_accessor<double>(handle);
+    const std::vector<std::vector<Tuple>> rings = vertex_rings(mesh);
+
+    int64_t n_queries = 0;
+    for (auto _ : state) {
+        for (const std::vector<Tuple>& ring : rings) {
+            bool inside = true;
+            std::array<Eigen::Vector3d, 3> triangle;
+            for (const Tuple& f : ring) {
+                const std::vector<Tuple> fv =
+                    simplex::faces_single_dimension_tuples(mesh, simplex::Simplex(PF, f), PV);
+                triangle[0] = accessor.const_vector_attribute(fv[0]);
+                triangle[1] = accessor.const_vector_attribute(fv[1]);
+                triangle[2] = accessor.const_vector_attribute(fv[2]);
+                if (fast_envelope->is_outside(triangle)) {
+                    inside = false;
+                    break;
+                }
+            }
+            benchmark::DoNotOptimize(inside);
+            n_queries += ring.size();
+        }
+    }
+    state.SetItemsProcessed(n_queries);
+}
+
+void invariant_after(
+    benchmark::State& state,
+    const TriMesh& mesh,
+    const attribute::MeshAttributeHandle& handle,
+    double envelope_size)
+{
+    const auto index = std::make_shared<envelope::EnvelopeIndex>(handle);
+    const invariants::EnvelopeInvariant invariant(index, envelope_size, handle);
+    const std::vector<std::vector<Tuple>> rings = vertex_rings(mesh);
+
+    int64_t n_queries = 0;
+    for (auto _ : state) {
+        for (const std::vector<Tuple>& ring : rings) {
+            benchmark::DoNotOptimize(invariant.after({}, ring));
+            n_queries += ring.size();
+        }
+    }
+    state.SetItemsProcessed(n_queries);
+}
+
+void BM_Envelope_per_triangle(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tri_grid(state.range(0));
+    const auto handle = add_surface_position(*mesh);
+    per_triangle(state, *mesh, handle, 1e-2);
+}
+BENCHMARK(BM_Envelope_per_triangle)->Arg(64);
+
+void BM_EnvelopeInvariant_after(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tri_grid(state.range(0));
+    const auto handle = add_surface_position(*mesh);
+    invariant_after(state, *mesh, handle, 1e-2);
+}
+BENCHMARK(BM_EnvelopeInvariant_after)->Arg(64);
+
+void BM_Envelope_per_triangle_data(benchmark::State& state)
+{
+    const auto mesh = read_data_mesh();
+    const auto handle = mesh->get_attribute_handle<double>(benchmarks::position_name, PV);
+    per_triangle(state, *mesh, handle, data_envelope_size(*mesh, handle));
+}
+BENCHMARK(BM_Envelope_per_triangle_data);
+
+void BM_EnvelopeInvariant_after_data(benchmark::State& state)
+{
+    const auto mesh = read_data_mesh();
+    const auto handle = mesh->get_attribute_handle<double>(benchmarks::position_name, PV);
+    invariant_after(state, *mesh, handle, data_envelope_size(*mesh, handle));
+}
+BENCHMARK(BM_EnvelopeInvariant_after_data);
+
+} // namespace
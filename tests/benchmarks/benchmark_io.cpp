@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/io/HDF5Reader.hpp>
+#include <wmtk/io/HDF5Writer.hpp>
+
+#include "grids.hpp"
+
+using namespace wmtk;
+
+namespace {
+
+std::filesystem::path benchmark_file(const std::string& name)
+{
+    return std::filesystem::temp_directory_path() / ("wmtk_benchmark_" + name + ".hdf5");
+}
+
+int64_t bytes_on_disk(const std::filesystem::path& path)
+{
+    return static_cast<int64_t>(std::filesystem::file_size(path));
+}
+
+HDF5WriterOptions writer_options(const benchmark::State& state)
+{
+    HDF5WriterOptions options;
+    options.chunk_size = state.range(1);
+    options.compression_level = static_cast<int>(state.range(2));
+    return options;
+}
+
+// grid size, chunk size, compression level
+void io_arguments(benchmark::internal::Benchmark* b)
+{
+    for (const int64_t n : {8, 24}) {
+        b->Args({n, 0, 0});
+        b->Args({n, HDF5WriterOptions::default_chunk_size, 0});
+        b->Args({n, HDF5WriterOptions::default_chunk_size, 1});
+        b->Args({n, HDF5WriterOptions::default_chunk_size, 6});
+    }
+}
+
+void BM_HDF5_write(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    const std::filesystem::path path = benchmark_file("write");
+    const HDF5WriterOptions options = writer_options(state);
+
+    for (auto _ : state) {
+        HDF5Writer writer(path, options);
+        mesh->serialize(writer);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes_on_disk(path));
+    state.counters["file_bytes"] = bytes_on_disk(path);
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_HDF5_write)->Apply(io_arguments)->Unit(benchmark::kMillisecond);
+
+void BM_HDF5_read(benchmark::State& state)
+{
+    const std::filesystem::path path = benchmark_file("read");
+    {
+        const auto mesh = benchmarks::tet_grid(state.range(0));
+        HDF5Writer writer(path, writer_options(state));
+        mesh->serialize(writer);
+    }
+
+    for (auto _ : state) {
+        HDF5Reader reader;
+        benchmark::DoNotOptimize(reader.read(path));
+    }
+    state.SetBytesProcessed(state.iterations() * bytes_on_disk(path));
+    state.counters["file_bytes"] = bytes_on_disk(path);
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_HDF5_read)->Apply(io_arguments)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <wmtk/Scheduler.hpp>
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/TriMesh.hpp>
+#include <wmtk/invariants/MultiMeshLinkConditionInvariant.hpp>
+#include <wmtk/operations/EdgeCollapse.hpp>
+#include <wmtk/operations/EdgeSplit.hpp>
+#include <wmtk/utils/Logger.hpp>
+
+#include "grids.hpp"
+
+using namespace wmtk;
+
+namespace {
+
+std::shared_ptr<Mesh> make_grid(PrimitiveType top_type, int64_t n)
+{
+    if (top_type == PrimitiveType::Triangle) {
+        return benchmarks::tri_grid(n);
+    } else {
+        return benchmarks::tet_grid(n);
+    }
+}
+
+// one pass of splits over all edges of a fresh grid, only the pass is measured
+void BM_EdgeSplit(benchmark::State& state, PrimitiveType top_type)
+{
+    logger().set_level(spdlog::level::off);
+    int64_t successes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto mesh = make_grid(top_type, state.range(0));
+        Mesh& m = *mesh;
+        auto pos_handle =
+            m.get_attribute_handle<double>(benchmarks::position_name, PrimitiveType::Vertex);
+        operations::EdgeSplit op(m);
+        op.set_new_attribute_strategy(pos_handle);
+        Scheduler scheduler;
+        state.ResumeTiming();
+
+        successes += scheduler.run_operation_on_all(op).number_of_successful_operations();
+    }
+    state.counters["operations"] = benchmark::Counter(successes, benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_EdgeSplit, TriMesh, PrimitiveType::Triangle)
+    ->Arg(32)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_EdgeSplit, TetMesh, PrimitiveType::Tetrahedron)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+
+// one pass of link condition preserving collapses over all edges of a fresh grid
+void BM_EdgeCollapse(benchmark::State& state, PrimitiveType top_type)
+{
+    logger().set_level(spdlog::level::off);
+    int64_t successes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto mesh = make_grid(top_type, state.range(0));
+        Mesh& m = *mesh;
+        auto pos_handle =
+            m.get_attribute_handle<double>(benchmarks::position_name, PrimitiveType::Vertex);
+        operations::EdgeCollapse op(m);
+        op.add_invariant(std::make_shared<MultiMeshLinkConditionInvariant>(m));
+        op.set_new_attribute_strategy(pos_handle);
+        Scheduler scheduler;
+        state.ResumeTiming();
+
+        successes += scheduler.run_operation_on_all(op).number_of_successful_operations();
+    }
+    state.counters["operations"] = benchmark::Counter(successes, benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_EdgeCollapse, TriMesh, PrimitiveType::Triangle)
+    ->Arg(32)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_EdgeCollapse, TetMesh, PrimitiveType::Tetrahedron)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
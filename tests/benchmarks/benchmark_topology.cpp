@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/TriMesh.hpp>
+#include <wmtk/simplex/SimplexCollection.hpp>
+#include <wmtk/simplex/closed_star.hpp>
+#include <wmtk/simplex/link_condition.hpp>
+#include <wmtk/simplex/top_dimension_cofaces.hpp>
+
+#include "grids.hpp"
+
+using namespace wmtk;
+
+namespace {
+
+constexpr PrimitiveType PV = PrimitiveType::Vertex;
+constexpr PrimitiveType PE = PrimitiveType::Edge;
+constexpr PrimitiveType PF = PrimitiveType::Triangle;
+constexpr PrimitiveType PT = PrimitiveType::Tetrahedron;
+
+template <typename MeshType>
+std::shared_ptr<MeshType> make_grid(int64_t n)
+{
+    if constexpr (std::is_same_v<MeshType, TriMesh>) {
+        return benchmarks::tri_grid(n);
+    } else {
+        return benchmarks::tet_grid(n);
+    }
+}
+
+void BM_TriMesh_switch_tuple(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tri_grid(state.range(0));
+    const TriMesh& m = *mesh;
+    const std::vector<Tuple> faces = m.get_all(PF);
+
+    for (auto _ : state) {
+        for (const Tuple& f : faces) {
+            Tuple t = f;
+            for (int64_t j = 0; j < 3; ++j) {
+                t = m.switch_tuple(m.switch_tuple(t, PV), PE);
+                benchmark::DoNotOptimize(t);
+                if (!m.is_boundary(PE, t)) {
+                    benchmark::DoNotOptimize(m.switch_tuple(t, PF));
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * faces.size());
+}
+BENCHMARK(BM_TriMesh_switch_tuple)->Arg(64)->Arg(256);
+
+void BM_TetMesh_switch_tuple(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    const TetMesh& m = *mesh;
+    const std::vector<Tuple> tets = m.get_all(PT);
+
+    for (auto _ : state) {
+        for (const Tuple& tet : tets) {
+            Tuple t = tet;
+            for (int64_t j = 0; j < 4; ++j) {
+                t = m.switch_tuple(m.switch_tuple(m.switch_tuple(t, PV), PE), PF);
+                benchmark::DoNotOptimize(t);
+                if (!m.is_boundary(PF, t)) {
+                    benchmark::DoNotOptimize(m.switch_tuple(t, PT));
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * tets.size());
+}
+BENCHMARK(BM_TetMesh_switch_tuple)->Arg(8)->Arg(24);
+
+template <typename MeshType>
+void BM_top_dimension_cofaces(benchmark::State& state)
+{
+    const auto mesh = make_grid<MeshType>(state.range(0));
+    const MeshType& m = *mesh;
+    const std::vector<Tuple> vertices = m.get_all(PV);
+
+    std::vector<Tuple> cofaces;
+    for (auto _ : state) {
+        for (const Tuple& v : vertices) {
+            cofaces.clear();
+            simplex::top_dimension_cofaces_tuples(m, simplex::Simplex::vertex(v), cofaces);
+            benchmark::DoNotOptimize(cofaces.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * vertices.size());
+}
+BENCHMARK_TEMPLATE(BM_top_dimension_cofaces, TriMesh)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(BM_top_dimension_cofaces, TetMesh)->Arg(8)->Arg(24);
+
+template <typename MeshType>
+void BM_link_condition(benchmark::State& state)
+{
+    const auto mesh = make_grid<MeshType>(state.range(0));
+    const MeshType& m = *mesh;
+    const std::vector<Tuple> edges = m.get_all(PE);
+
+    for (auto _ : state) {
+        int64_t count = 0;
+        for (const Tuple& e : edges) {
+            count += simplex::link_condition(m, e);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * edges.size());
+}
+BENCHMARK_TEMPLATE(BM_link_condition, TriMesh)->Arg(32)->Arg(64);
+BENCHMARK_TEMPLATE(BM_link_condition, TetMesh)->Arg(4)->Arg(8);
+
+// sorts the unsorted closed stars of all vertices, the copy of the simplices is part of the
+// measured time
+template <typename MeshType>
+void BM_sort_and_clean(benchmark::State& state)
+{
+    const auto mesh = make_grid<MeshType>(state.range(0));
+    const MeshType& m = *mesh;
+
+    std::vector<std::vector<simplex::Simplex>> stars;
+    for (const Tuple& v : m.get_all(PV)) {
+        stars.emplace_back(
+            simplex::closed_star(m, simplex::Simplex::vertex(v), false).simplex_vector());
+    }
+
+    for (auto _ : state) {
+        for (const std::vector<simplex::Simplex>& star : stars) {
+            simplex::SimplexCollection collection(m, std::vector<simplex::Simplex>(star));
+            collection.sort_and_clean();
+            benchmark::DoNotOptimize(collection.simplex_vector().data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * stars.size());
+}
+BENCHMARK_TEMPLATE(BM_sort_and_clean, TriMesh)->Arg(32)->Arg(128);
+BENCHMARK_TEMPLATE(BM_sort_and_clean, TetMesh)->Arg(4)->Arg(12);
+
+} // namespace
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <wmtk/PackedTuple.hpp>
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/simplex/Simplex.hpp>
+#include <wmtk/utils/TupleInspector.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "grids.hpp"
+
+using namespace wmtk;
+
+namespace {
+
+constexpr PrimitiveType PE = PrimitiveType::Edge;
+
+// what the scheduler does with its candidates: shuffle them and visit them in order
+template <typename Element, typename ToTuple>
+void shuffle_and_visit(benchmark::State& state, std::vector<Element> candidates, ToTuple to_tuple)
+{
+    std::mt19937 gen(0);
+    for (auto _ : state) {
+        std::shuffle(candidates.begin(), candidates.end(), gen);
+        int64_t sum = 0;
+        for (const Element& c : candidates) {
+            sum += utils::TupleInspector::global_cid(to_tuple(c));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * candidates.size());
+    state.SetBytesProcessed(state.iterations() * candidates.size() * sizeof(Element));
+}
+
+void BM_candidates_simplex(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    std::vector<simplex::Simplex> candidates;
+    for (const Tuple& t : mesh->get_all(PE)) {
+        candidates.emplace_back(PE, t);
+    }
+    shuffle_and_visit(state, std::move(candidates), [](const simplex::Simplex& s) {
+        return s.tuple();
+    });
+}
+BENCHMARK(BM_candidates_simplex)->Arg(16)->Arg(64);
+
+void BM_candidates_tuple(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    shuffle_and_visit(state, mesh->get_all(PE), [](const Tuple& t) { return t; });
+}
+BENCHMARK(BM_candidates_tuple)->Arg(16)->Arg(64);
+
+void BM_candidates_packed(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    shuffle_and_visit(state, mesh->get_all_packed(PE), [](const PackedTuple& t) {
+        return t.unpack();
+    });
+}
+BENCHMARK(BM_candidates_packed)->Arg(16)->Arg(64);
+
+void BM_get_all(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mesh->get_all(PE));
+    }
+}
+BENCHMARK(BM_get_all)->Arg(64);
+
+void BM_get_all_packed(benchmark::State& state)
+{
+    const auto mesh = benchmarks::tet_grid(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mesh->get_all_packed(PE));
+    }
+}
+BENCHMARK(BM_get_all_packed)->Arg(64);
+
+} // namespace
@@ -0,0 +1,33 @@
+#include "grids.hpp"
+
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/TriMesh.hpp>
+#include <wmtk/components/procedural/internal/Grid2Options.hpp>
+#include <wmtk/components/procedural/internal/Grid3Options.hpp>
+#include <wmtk/components/procedural/internal/make_mesh.hpp>
+
+namespace wmtk::benchmarks {
+
+std::shared_ptr<TriMesh> tri_grid(int64_t n)
+{
+    using components::internal::Grid2Options;
+    Grid2Options opt;
+    opt.tiling_type = Grid2Options::TilingType::Diagonal;
+    opt.dimensions = {{n, n}};
+    opt.coordinates = Grid2Options::Coordinates{position_name, {{1., 1.}}};
+
+    return std::static_pointer_cast<TriMesh>(components::internal::procedural::make_mesh(opt));
+}
+
+std::shared_ptr<TetMesh> tet_grid(int64_t n)
+{
+    using components::internal::Grid3Options;
+    Grid3Options opt;
+    opt.tiling_type = Grid3Options::TilingType::Freudenthal;
+    opt.dimensions = {{n, n, n}};
+    opt.coordinates = Grid3Options::Coordinates{position_name, {{1., 1., 1.}}};
+
+    return std::static_pointer_cast<TetMesh>(components::internal::procedural::make_mesh(opt));
+}
+
+} // namespace wmtk::benchmarks
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace wmtk {
+class TriMesh;
+class TetMesh;
+} // namespace wmtk
+
+namespace wmtk::benchmarks {
+
+// name of the vertex position attribute of the grids below
+inline const std::string position_name = "vertices";
+
+/// diagonal triangle grid of n x n squares with unit spacing
+std::shared_ptr<TriMesh> tri_grid(int64_t n);
+/// freudenthal tetrahedral grid of n x n x n cubes with unit spacing
+std::shared_ptr<TetMesh> tet_grid(int64_t n);
+
+} // namespace wmtk::benchmarks
@@ -2,12 +2,15 @@
 #include <wmtk/Primitive.hpp>
 #include <wmtk/TriMesh.hpp>
 #include <wmtk/function/Function.hpp>
+#include <wmtk/function/LocalNeighborsSumFunction.hpp>
 #include <wmtk/function/simplex/TriangleAMIPS.hpp>
 // #include <wmtk/function/PositionMapAMIPS2D.hpp>
 #include <wmtk/function/simplex/EdgeValenceEnergy.hpp>
 #include <wmtk/simplex/Simplex.hpp>
 #include "../tools/DEBUG_TriMesh.hpp"
 #include "../tools/TriMesh_examples.hpp"
+
+#include <random>
 using namespace wmtk;
 using namespace wmtk::function;
 using namespace wmtk::tests;
@@ -70,6 +73,76 @@ TEST_CASE("amips2d_values")
     }
 }
 
+TEST_CASE("amips2d_closed_form")
+{
+    // the closed form against the autodiff encoding it replaced
+    auto close = [](double a, double b) { return std::abs(a - b) <= 1e-9 * (1 + std::abs(b)); };
+
+    for (const int dimension : {2, 3}) {
+        TriMesh m = ten_triangles_with_position(dimension);
+        auto handle = m.get_attribute_handle<double>("vertices", PrimitiveType::Vertex);
+
+        std::mt19937 gen(dimension);
+        std::uniform_real_distribution<double> noise(-0.03, 0.03);
+        {
+            auto acc = m.create_accessor<double>(handle);
+            for (const Tuple& v : m.get_all(PrimitiveType::Vertex)) {
+                for (int d = 0; d < dimension; ++d) {
+                    acc.vector_attribute(v)[d] += noise(gen);
+                }
+            }
+        }
+
+        TriangleAMIPS amips(m, handle);
+        const PerSimplexAutodiffFunction& autodiff = amips;
+
+        for (const Tuple& f : m.get_all(PrimitiveType::Triangle)) {
+            const Simplex face(PrimitiveType::Triangle, f);
+            CHECK(close(
+                amips.get_value(face),
+                autodiff.PerSimplexAutodiffFunction::get_value(face)));
+
+            for (const Tuple& t :
+                 {f,
+                  m.switch_tuple(f, PrimitiveType::Vertex),
+                  m.switch_tuples(f, {PrimitiveType::Edge, PrimitiveType::Vertex})}) {
+                const Simplex vertex(PrimitiveType::Vertex, t);
+                const Eigen::VectorXd g = amips.get_gradient(face, vertex);
+                const Eigen::VectorXd g_ad =
+                    autodiff.PerSimplexAutodiffFunction::get_gradient(face, vertex);
+                const Eigen::MatrixXd h = amips.get_hessian(face, vertex);
+                const Eigen::MatrixXd h_ad =
+                    autodiff.PerSimplexAutodiffFunction::get_hessian(face, vertex);
+                REQUIRE(g.size() == dimension);
+                REQUIRE(h.rows() == dimension);
+                for (int i = 0; i < dimension; ++i) {
+                    CHECK(close(g[i], g_ad[i]));
+                    for (int j = 0; j < dimension; ++j) {
+                        CHECK(close(h(i, j), h_ad(i, j)));
+                    }
+                }
+            }
+        }
+
+        // the fixed size accumulation of the neighborhood sum
+        LocalNeighborsSumFunction sum(m, handle, amips);
+        for (const Tuple& v : m.get_all(PrimitiveType::Vertex)) {
+            const Simplex vertex(PrimitiveType::Vertex, v);
+            Eigen::VectorXd g = Eigen::VectorXd::Zero(dimension);
+            Eigen::MatrixXd h = Eigen::MatrixXd::Zero(dimension, dimension);
+            for (const Simplex& face : sum.domain(vertex)) {
+                g += autodiff.PerSimplexAutodiffFunction::get_gradient(face, vertex);
+                h += autodiff.PerSimplexAutodiffFunction::get_hessian(face, vertex);
+            }
+            const Eigen::VectorXd sum_g = sum.get_gradient(vertex);
+            const Eigen::MatrixXd sum_h = sum.get_hessian(vertex);
+            REQUIRE(sum_g.size() == dimension);
+            CHECK((sum_g - g).norm() <= 1e-9 * (1 + g.norm()));
+            CHECK((sum_h - h).norm() <= 1e-9 * (1 + h.norm()));
+        }
+    }
+}
+
 // TEST_CASE("PositionMapAMIPS_values")
 // {
 //     SECTION("equilateral_triangle")
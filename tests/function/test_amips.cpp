@@ -1,6 +1,14 @@
 #include <iostream>
 #include <catch2/catch_test_macros.hpp>
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/function/LocalNeighborsSumFunction.hpp>
+#include <wmtk/function/simplex/AMIPS.hpp>
 #include <wmtk/function/utils/amips.hpp>
+#include <wmtk/function/utils/amips_one_ring.hpp>
+#include <wmtk/simplex/cofaces_single_dimension.hpp>
+#include "../tools/TetMesh_examples.hpp"
+
+#include <random>
 
 TEST_CASE("amips2d")
 {
@@ -28,3 +36,62 @@ TEST_CASE("amips3d")
         CHECK(wmtk::function::utils::amips(uv0,uv1,uv2) == 2.0);
     }
 }
+
+TEST_CASE("amips_tet_one_ring")
+{
+    using namespace wmtk;
+
+    SECTION("regular_tet")
+    {
+        wmtk::function::utils::TetOneRing ring;
+        ring.clear(Eigen::Vector3d(1, 1, 1));
+        ring.push_back(
+            Eigen::Vector3d(1, -1, -1),
+            Eigen::Vector3d(-1, 1, -1),
+            Eigen::Vector3d(-1, -1, 1));
+        Eigen::Vector3d g = Eigen::Vector3d::Zero();
+        CHECK(std::abs(wmtk::function::utils::Tet_AMIPS_one_ring(ring, &g) - 3) < 1e-12);
+        CHECK(g.norm() < 1e-12);
+    }
+
+    SECTION("grid")
+    {
+        // the batched one rings against the sum of the per tet kernels
+        TetMesh m = tests_3d::two_by_two_by_two_grids_tets();
+        auto handle = m.register_attribute<double>("vertices", PrimitiveType::Vertex, 3);
+
+        std::mt19937 gen(5);
+        std::uniform_real_distribution<double> noise(-0.2, 0.2);
+        {
+            auto acc = m.create_accessor<double>(handle);
+            int64_t j = 0;
+            for (const Tuple& v : m.get_all(PrimitiveType::Vertex)) {
+                acc.vector_attribute(v) = Eigen::Vector3d(j % 3, (j / 3) % 3, j / 9) +
+                                          Eigen::Vector3d(noise(gen), noise(gen), noise(gen));
+                ++j;
+            }
+        }
+
+        function::AMIPS amips(m, handle);
+        function::LocalNeighborsSumFunction sum(m, handle, amips);
+
+        for (const Tuple& v : m.get_all(PrimitiveType::Vertex)) {
+            const simplex::Simplex vertex(PrimitiveType::Vertex, v);
+            const std::vector<simplex::Simplex> tets =
+                simplex::cofaces_single_dimension_simplices(m, vertex, PrimitiveType::Tetrahedron);
+
+            double value = 0;
+            Eigen::Vector3d g = Eigen::Vector3d::Zero();
+            Eigen::Matrix3d h = Eigen::Matrix3d::Zero();
+            for (const simplex::Simplex& tet : tets) {
+                value += amips.get_value(tet);
+                g += amips.get_gradient(tet, vertex);
+                h += amips.get_hessian(tet, vertex);
+            }
+
+            CHECK(std::abs(sum.get_value(vertex) - value) <= 1e-10 * value);
+            CHECK((sum.get_gradient(vertex) - g).norm() <= 1e-10 * (1 + g.norm()));
+            CHECK((sum.get_hessian(vertex) - h).norm() <= 1e-10 * (1 + h.norm()));
+        }
+    }
+}
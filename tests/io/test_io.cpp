@@ -15,6 +15,7 @@
 #include "../tools/TriMesh_examples.hpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <h5pp/h5pp.h>
 #include <wmtk/simplex/utils/SimplexComparisons.hpp>
 
 
@@ -84,6 +85,117 @@ TEST_CASE("hdf5_rational", "[io]")
     CHECK(*mesh1 == mesh);
 }
 
+TEST_CASE("rational_binary_encoding", "[io]")
+{
+    std::vector<Rational> values;
+    values.emplace_back(0);
+    values.emplace_back(-0.375);
+    values.emplace_back(1e300);
+    values.emplace_back(Rational(1) / Rational(3));
+    values.emplace_back(-Rational(2) / Rational(7));
+    values.emplace_back(pow(Rational(3), 100) / pow(Rational(7), 50));
+    // not canonical, must keep its numerator and denominator
+    values.emplace_back("6", "4");
+
+    std::vector<uint8_t> bytes;
+    for (const Rational& r : values) {
+        r.write_binary(bytes);
+    }
+    // the value exactly representable as double only needs the tag and 8 bytes
+    std::vector<uint8_t> double_bytes;
+    values[1].write_binary(double_bytes);
+    CHECK(double_bytes.size() == 9);
+
+    const uint8_t* data = bytes.data();
+    const uint8_t* end = bytes.data() + bytes.size();
+    for (const Rational& r : values) {
+        Rational read;
+        data = read.read_binary(data, end);
+        CHECK(read == r);
+        CHECK(read.numerator() == r.numerator());
+        CHECK(read.denominator() == r.denominator());
+    }
+    CHECK(data == end);
+
+    std::vector<uint8_t> large_bytes;
+    values[5].write_binary(large_bytes);
+    Rational truncated;
+    CHECK_THROWS(truncated.read_binary(large_bytes.data(), large_bytes.data() + 8));
+}
+
+TEST_CASE("hdf5_rational_string_layout", "[io]")
+{
+    Eigen::Matrix<int64_t, 2, 4> T;
+    T << 0, 1, 2, 3, 4, 5, 6, 7;
+    TetMesh mesh;
+    mesh.initialize(T);
+
+    HDF5Writer writer("hdf5_rational_string_layout.hdf5");
+    mesh.serialize(writer);
+
+    // add a rational attribute in the layout written before the binary encoding
+    std::vector<Rational> values;
+    std::vector<std::string> strings;
+    for (int64_t i = 0; i < 8; ++i) {
+        values.emplace_back(Rational(i + 1) / Rational(3));
+        strings.emplace_back(values.back().numerator());
+        strings.emplace_back(values.back().denominator());
+    }
+    {
+        h5pp::File file("hdf5_rational_string_layout.hdf5", h5pp::FileAccess::READWRITE);
+        const std::string dataset = "WMTK/0/rational_values";
+        file.writeDataset(strings, dataset);
+        file.writeAttribute(int64_t(1), dataset, "stride");
+        file.writeAttribute(std::string("0"), dataset, "default_value");
+        file.writeAttribute(int64_t(0), dataset, "dimension");
+        file.writeAttribute(std::string("rational"), dataset, "type");
+    }
+
+    auto mesh1 = read_mesh("hdf5_rational_string_layout.hdf5");
+    auto handle = mesh1->get_attribute_handle<Rational>("rational_values", PV);
+    auto acc = mesh1->create_const_accessor<Rational>(handle);
+    const auto vertices = mesh1->get_all(PV);
+    REQUIRE(vertices.size() == values.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        CHECK(acc.const_scalar_attribute(vertices[i]) == values[i]);
+    }
+}
+
+TEST_CASE("hdf5_chunked_compressed", "[io]")
+{
+    Eigen::Matrix<int64_t, 2, 4> T;
+    T << 0, 1, 2, 3, 4, 5, 6, 7;
+    TetMesh mesh;
+    mesh.initialize(T);
+    Eigen::Matrix<Rational, 8, 3> V;
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            V(i, j) = Rational(std::rand()) / Rational(std::rand());
+        }
+    }
+    mesh_utils::set_matrix_attribute(V, "vertices", PrimitiveType::Vertex, mesh);
+
+    auto tag_handle = mesh.register_attribute<char>("tag", PrimitiveType::Tetrahedron, 1, false, -1);
+    auto tag_acc = mesh.create_accessor<char>(tag_handle);
+    for (const Tuple& t : mesh.get_all(PrimitiveType::Tetrahedron)) {
+        tag_acc.scalar_attribute(t) = -100;
+    }
+
+    HDF5WriterOptions options;
+    options.chunk_size = 5;
+    options.compression_level = 6;
+    {
+        HDF5Writer writer("hdf5_chunked_compressed.hdf5", options);
+        mesh.serialize(writer);
+    }
+
+    auto mesh1 = read_mesh("hdf5_chunked_compressed.hdf5");
+    CHECK(*mesh1 == mesh);
+
+    options.compression_level = 10;
+    CHECK_THROWS(HDF5Writer("hdf5_invalid_options.hdf5", options));
+}
+
 TEST_CASE("paraview_2d", "[io]")
 {
     auto mesh = read_mesh(WMTK_DATA_DIR "/fan.msh");
@@ -4,9 +4,15 @@
 #include <wmtk/PointMesh.hpp>
 #include <wmtk/TetMesh.hpp>
 #include <wmtk/TriMesh.hpp>
+#include <wmtk/invariants/MultiMeshLinkConditionInvariant.hpp>
+#include <wmtk/io/MeshWriter.hpp>
 #include <wmtk/multimesh/consolidate.hpp>
 #include <wmtk/operations/EdgeCollapse.hpp>
 #include <wmtk/operations/EdgeSplit.hpp>
+#include <wmtk/simplex/faces_single_dimension.hpp>
+
+#include <map>
+#include <set>
 
 #include "tools/DEBUG_TetMesh.hpp"
 #include "tools/DEBUG_TriMesh.hpp"
@@ -26,6 +32,76 @@ constexpr PrimitiveType PV = PrimitiveType::Vertex;
 constexpr PrimitiveType PE = PrimitiveType::Edge;
 constexpr PrimitiveType PF = PrimitiveType::Triangle;
 constexpr PrimitiveType PT = PrimitiveType::Tetrahedron;
+
+namespace {
+// keeps everything that is written in memory so that two serializations can be compared
+class RecordingWriter : public MeshWriter
+{
+public:
+    bool write(const int) override { return true; }
+    void write_top_simplex_type(const PrimitiveType type) override
+    {
+        m_data[m_id]["top_simplex_type"] = {double(get_primitive_type_id(type))};
+    }
+    void write_absolute_id(const std::vector<int64_t>& id) override { m_id = id; }
+    void write_capacities(const std::vector<int64_t>& capacities) override
+    {
+        record("capacities", -1, capacities);
+    }
+
+    void write(
+        const std::string& name,
+        const int64_t type,
+        const int64_t,
+        const std::vector<char>& val,
+        const char) override
+    {
+        record(name, type, val);
+    }
+    void write(
+        const std::string& name,
+        const int64_t type,
+        const int64_t,
+        const std::vector<int64_t>& val,
+        const int64_t) override
+    {
+        record(name, type, val);
+    }
+    void write(
+        const std::string& name,
+        const int64_t type,
+        const int64_t,
+        const std::vector<double>& val,
+        const double) override
+    {
+        record(name, type, val);
+    }
+    void write(
+        const std::string& name,
+        const int64_t type,
+        const int64_t,
+        const std::vector<Rational>& val,
+        const Rational&) override
+    {
+        record(name, type, val);
+    }
+
+    std::map<std::vector<int64_t>, std::map<std::string, std::vector<double>>> m_data;
+
+private:
+    template <typename T>
+    void record(const std::string& name, const int64_t type, const std::vector<T>& val)
+    {
+        std::vector<double>& data = m_data[m_id][name + "_" + std::to_string(type)];
+        for (const T& v : val) {
+            data.push_back(double(v));
+        }
+    }
+
+    std::vector<int64_t> m_id;
+};
+} // namespace
+
 TEST_CASE("consolidate_multimesh", "[mesh][consolidate_multimesh]")
 {
     using namespace wmtk::operations;
@@ -169,3 +245,210 @@ TEST_CASE("consolidate_multimesh_splits", "[mesh][consolidate_multimesh]")
         }
     }
 }
+
+TEST_CASE("serialize_consolidated", "[mesh][consolidate_multimesh]")
+{
+    auto dptr = disk_to_individual_multimesh(10);
+    auto& c = dptr->get_multi_mesh_child_mesh({0});
+
+    // every split deletes the split edge and its incident triangles
+    operations::EdgeSplit split_op(*dptr);
+    for (int j = 0; j < 2; ++j) {
+        for (const auto& tup : dptr->get_all(PE)) {
+            split_op(simplex::Simplex::edge(tup));
+        }
+    }
+    REQUIRE(dptr->get_all(PF).size() < dptr->capacity(PF));
+
+    const size_t hash = dptr->hash();
+    const size_t child_hash = c.hash();
+
+    RecordingWriter live_writer;
+    dptr->serialize_consolidated(live_writer);
+    RecordingWriter live_child_writer;
+    c.serialize_consolidated(live_child_writer, &c);
+
+    // the mesh is not touched
+    CHECK(dptr->hash() == hash);
+    CHECK(c.hash() == child_hash);
+
+    multimesh::consolidate(*dptr);
+
+    RecordingWriter writer;
+    dptr->serialize(writer);
+    RecordingWriter child_writer;
+    c.serialize(child_writer, &c);
+
+    CHECK(live_writer.m_data.size() == 2);
+    CHECK(live_writer.m_data == writer.m_data);
+    CHECK(live_child_writer.m_data == child_writer.m_data);
+}
+
+namespace {
+// registers an attribute holding the id of every simplex of the given type
+template <typename MeshType>
+attribute::TypedAttributeHandle<int64_t> tag_ids(MeshType& m, PrimitiveType pt)
+{
+    auto handle = m.template register_attribute_typed<int64_t>("ids", pt, 1);
+    auto acc = m.create_accessor(handle);
+    for (const Tuple& t : m.get_all(pt)) {
+        acc.scalar_attribute(t) = m.id(t, pt);
+    }
+    return handle;
+}
+
+// the top simplices by the tags of their vertices, which do not change when consolidating
+std::set<std::vector<int64_t>> tagged_top_simplices(
+    const Mesh& m,
+    const attribute::TypedAttributeHandle<int64_t>& vertex_tags,
+    const attribute::TypedAttributeHandle<int64_t>& top_tags)
+{
+    const auto v_acc = m.create_const_accessor(vertex_tags);
+    const auto t_acc = m.create_const_accessor(top_tags);
+    const PrimitiveType top = m.top_simplex_type();
+    std::set<std::vector<int64_t>> res;
+    for (const Tuple& t : m.get_all(top)) {
+        std::vector<int64_t> tags;
+        for (const Simplex& v : faces_single_dimension(m, Simplex(top, t), PV)) {
+            tags.push_back(v_acc.const_scalar_attribute(v.tuple()));
+        }
+        std::sort(tags.begin(), tags.end());
+        tags.push_back(t_acc.const_scalar_attribute(t));
+        res.insert(tags);
+    }
+    return res;
+}
+
+template <typename MeshType>
+void check_incrementally_consolidated(
+    const MeshType& m,
+    const std::vector<std::vector<std::array<int64_t, 2>>>& moves,
+    const std::vector<std::pair<PrimitiveType, attribute::TypedAttributeHandle<int64_t>>>& tags)
+{
+    for (const attribute::StorageStats& s : m.storage_stats()) {
+        CHECK(s.capacity == s.live);
+    }
+    // the simplices that were not moved keep their ids
+    for (const auto& [pt, handle] : tags) {
+        const int64_t d = get_primitive_type_id(pt);
+        std::map<int64_t, int64_t> old_ids;
+        for (const auto& [old_id, new_id] : moves[d]) {
+            CHECK(new_id < m.capacity(pt));
+            CHECK(old_id >= m.capacity(pt));
+            old_ids[new_id] = old_id;
+        }
+        const auto acc = m.create_const_accessor(handle);
+        for (const Tuple& t : m.get_all(pt)) {
+            const int64_t id = m.id(t, pt);
+            const int64_t old_id = old_ids.count(id) == 0 ? id : old_ids.at(id);
+            CHECK(acc.const_scalar_attribute(t) == old_id);
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("consolidate_incremental", "[mesh][consolidate_multimesh]")
+{
+    SECTION("2D")
+    {
+        auto dptr = disk_to_individual_multimesh(20);
+        DEBUG_TriMesh& parent = reinterpret_cast<DEBUG_TriMesh&>(*dptr);
+        DEBUG_TriMesh& child =
+            reinterpret_cast<DEBUG_TriMesh&>(parent.get_multi_mesh_child_mesh({0}));
+
+        // a child of lower dimension on an edge of the disk
+        std::shared_ptr<DEBUG_EdgeMesh> edge_child_ptr =
+            std::make_shared<DEBUG_EdgeMesh>(single_line());
+        DEBUG_EdgeMesh& edge_child = *edge_child_ptr;
+        std::vector<std::array<Tuple, 2>> edge_map(1);
+        edge_map[0] = {edge_child.tuple_from_edge_id(0), parent.tuple_from_id(PE, 0)};
+        parent.register_child_mesh(edge_child_ptr, edge_map);
+
+        // every split frees the split edge and its triangles, collapses are left to the 3D
+        // section as they do not support the two children here
+        EdgeSplit split(parent);
+        for (const Tuple& e : parent.get_all(PE)) {
+            split(Simplex::edge(e));
+        }
+        REQUIRE(parent.get_all(PF).size() < parent.capacity(PF));
+
+        const auto parent_v = tag_ids(parent, PV);
+        const auto parent_e = tag_ids(parent, PE);
+        const auto parent_f = tag_ids(parent, PF);
+        const auto child_v = tag_ids(child, PV);
+        const auto child_f = tag_ids(child, PF);
+        const auto edge_child_v = tag_ids(edge_child, PV);
+        const auto edge_child_e = tag_ids(edge_child, PE);
+        const auto faces = tagged_top_simplices(parent, parent_v, parent_f);
+        const auto child_faces = tagged_top_simplices(child, child_v, child_f);
+        const auto edges = tagged_top_simplices(edge_child, edge_child_v, edge_child_e);
+
+        const auto moves = multimesh::consolidate_incremental(parent);
+        REQUIRE(moves.size() == 3);
+        CHECK(!moves.at({})[2].empty());
+
+        CHECK(parent.is_connectivity_valid());
+        CHECK(child.is_connectivity_valid());
+        CHECK(edge_child.is_connectivity_valid());
+        parent.multi_mesh_manager().check_map_valid(parent);
+        child.multi_mesh_manager().check_map_valid(child);
+        edge_child.multi_mesh_manager().check_map_valid(edge_child);
+
+        CHECK(tagged_top_simplices(parent, parent_v, parent_f) == faces);
+        CHECK(tagged_top_simplices(child, child_v, child_f) == child_faces);
+        CHECK(tagged_top_simplices(edge_child, edge_child_v, edge_child_e) == edges);
+        check_incrementally_consolidated(
+            parent,
+            moves.at({}),
+            {{PV, parent_v}, {PE, parent_e}, {PF, parent_f}});
+        check_incrementally_consolidated(child, moves.at({0}), {{PV, child_v}, {PF, child_f}});
+        check_incrementally_consolidated(
+            edge_child,
+            moves.at({1}),
+            {{PV, edge_child_v}, {PE, edge_child_e}});
+
+        // nothing left to move
+        const auto none = multimesh::consolidate_incremental(parent);
+        for (const auto& [id, mesh_moves] : none) {
+            for (const auto& dim_moves : mesh_moves) {
+                CHECK(dim_moves.empty());
+            }
+        }
+
+        // the consolidated mesh can be modified further
+        for (const Tuple& e : parent.get_all(PE)) {
+            split(Simplex::edge(e));
+        }
+        CHECK(parent.is_connectivity_valid());
+        parent.multi_mesh_manager().check_map_valid(parent);
+    }
+    SECTION("3D")
+    {
+        wmtk::tests_3d::DEBUG_TetMesh m = wmtk::tests_3d::two_by_two_by_two_grids_tets();
+
+        EdgeSplit split(m);
+        for (const Tuple& e : m.get_all(PE)) {
+            split(Simplex::edge(e));
+        }
+        EdgeCollapse collapse(m);
+        collapse.add_invariant(std::make_shared<MultiMeshLinkConditionInvariant>(m));
+        for (const Tuple& e : m.get_all(PE)) {
+            collapse(Simplex::edge(e));
+        }
+        REQUIRE(m.get_all(PT).size() < m.capacity(PT));
+
+        const auto tags_v = tag_ids(m, PV);
+        const auto tags_e = tag_ids(m, PE);
+        const auto tags_f = tag_ids(m, PF);
+        const auto tags_t = tag_ids(m, PT);
+        const auto tets = tagged_top_simplices(m, tags_v, tags_t);
+
+        const auto moves = m.consolidate_incremental();
+        CHECK(m.is_connectivity_valid());
+        CHECK(tagged_top_simplices(m, tags_v, tags_t) == tets);
+        check_incrementally_consolidated(
+            m,
+            moves,
+            {{PV, tags_v}, {PE, tags_e}, {PF, tags_f}, {PT, tags_t}});
+    }
+}
@@ -1,6 +1,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+
 #include <wmtk/Types.hpp>
 #include <wmtk/multimesh/same_simplex_dimension_bijection.hpp>
 #include "../tools/DEBUG_TetMesh.hpp"
@@ -116,3 +118,92 @@ TEST_CASE("test_absolute_ids", "[multimesh][ids]")
     CHECK(root->get_all_child_meshes().size() == 9);
 }
 
+
+namespace {
+const Mesh& mesh_from_relative_id(const Mesh& m, const std::vector<int64_t>& relative_id)
+{
+    const Mesh* cur = &m;
+    for (const int64_t id : relative_id) {
+        cur = cur->get_child_meshes().at(id).get();
+    }
+    return *cur;
+}
+
+// maps t from m up to its ancestor at depth ancestor_depth and then down to other as the tree was
+// walked before the routes avoided the absolute ids
+std::vector<Tuple> reference_map_tuples(
+    const Mesh& m,
+    const Mesh& other,
+    const Tuple& t,
+    size_t ancestor_depth)
+{
+    const PrimitiveType pt = PrimitiveType::Triangle;
+    const std::vector<int64_t> my_id = m.absolute_multi_mesh_id();
+    const std::vector<int64_t> other_id = other.absolute_multi_mesh_id();
+    const Mesh& root = m.get_multi_mesh_root();
+
+    Tuple up = t;
+    for (size_t depth = my_id.size(); depth > ancestor_depth; --depth) {
+        const std::vector<int64_t> id(my_id.begin(), my_id.begin() + depth);
+        up = mesh_from_relative_id(root, id).map_to_parent_tuple(simplex::Simplex(pt, up));
+    }
+
+    std::vector<Tuple> tuples{up};
+    for (size_t depth = ancestor_depth; depth < other_id.size(); ++depth) {
+        const std::vector<int64_t> id(other_id.begin(), other_id.begin() + depth);
+        const Mesh& cur = mesh_from_relative_id(root, id);
+        const Mesh& child = *cur.get_child_meshes().at(other_id[depth]);
+        std::vector<Tuple> next;
+        for (const Tuple& s : tuples) {
+            for (const Tuple& c : cur.map_to_child_tuples(child, simplex::Simplex(pt, s))) {
+                next.emplace_back(c);
+            }
+        }
+        tuples = std::move(next);
+    }
+    return tuples;
+}
+} // namespace
+
+TEST_CASE("test_map_routes", "[multimesh][ids]")
+{
+    auto root = disk(6);
+    auto map = wmtk::multimesh::same_simplex_dimension_bijection(*root, *root);
+
+    auto c0 = disk(6);
+    root->register_child_mesh(c0, map);
+    auto c1 = disk(6);
+    root->register_child_mesh(c1, map);
+    auto c00 = disk(6);
+    c0->register_child_mesh(c00, map);
+    auto c10 = disk(6);
+    c1->register_child_mesh(c10, map);
+    auto c100 = disk(6);
+    c10->register_child_mesh(c100, map);
+
+    const std::vector<std::shared_ptr<Mesh>> meshes{root, c0, c1, c00, c10, c100};
+
+    for (const auto& mptr : meshes) {
+        const std::vector<int64_t> my_id = mptr->absolute_multi_mesh_id();
+        for (const auto& nptr : meshes) {
+            const std::vector<int64_t> other_id = nptr->absolute_multi_mesh_id();
+            size_t lub_depth = 0;
+            while (lub_depth < std::min(my_id.size(), other_id.size()) &&
+                   my_id[lub_depth] == other_id[lub_depth]) {
+                ++lub_depth;
+            }
+
+            for (const Tuple& t : mptr->get_all(PrimitiveType::Triangle)) {
+                for (const Tuple& s : {t, mptr->switch_tuple(t, PrimitiveType::Vertex)}) {
+                    const simplex::Simplex simplex(PrimitiveType::Triangle, s);
+                    CHECK(
+                        mptr->map_tuples(*nptr, simplex) ==
+                        reference_map_tuples(*mptr, *nptr, s, 0));
+                    CHECK(
+                        mptr->lub_map_tuples(*nptr, simplex) ==
+                        reference_map_tuples(*mptr, *nptr, s, lub_depth));
+                }
+            }
+        }
+    }
+}
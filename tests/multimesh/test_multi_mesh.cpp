@@ -1073,32 +1073,33 @@ TEST_CASE("test_split_multi_mesh", "[multimesh][2D]")
     REQUIRE(child1.is_connectivity_valid());
     REQUIRE(child2.is_connectivity_valid());
 
+    // the new faces reuse the ids of the faces deleted by the first split
     CHECK(parent.fv_from_fid(2) == Vector3l(0, 2, 4));
     CHECK(parent.fv_from_fid(5) == Vector3l(5, 1, 2));
     CHECK(parent.fv_from_fid(3) == Vector3l(3, 1, 5));
-    CHECK(parent.fv_from_fid(9) == Vector3l(0, 6, 2));
-    CHECK(parent.fv_from_fid(10) == Vector3l(6, 5, 2));
-    CHECK(parent.fv_from_fid(7) == Vector3l(3, 6, 0));
-    CHECK(parent.fv_from_fid(8) == Vector3l(3, 5, 6));
+    CHECK(parent.fv_from_fid(7) == Vector3l(0, 6, 2));
+    CHECK(parent.fv_from_fid(8) == Vector3l(6, 5, 2));
+    CHECK(parent.fv_from_fid(1) == Vector3l(3, 6, 0));
+    CHECK(parent.fv_from_fid(0) == Vector3l(3, 5, 6));
 
     CHECK(child0.fv_from_fid(1) == Vector3l(3, 1, 2));
-    CHECK(child0.fv_from_fid(3) == Vector3l(0, 4, 2));
-    CHECK(child0.fv_from_fid(4) == Vector3l(4, 3, 2));
+    CHECK(child0.fv_from_fid(0) == Vector3l(0, 4, 2));
+    CHECK(child0.fv_from_fid(3) == Vector3l(4, 3, 2));
 
     CHECK(child1.fv_from_fid(4) == Vector3l(4, 1, 2));
     CHECK(child1.fv_from_fid(2) == Vector3l(3, 1, 4));
-    CHECK(child1.fv_from_fid(8) == Vector3l(0, 5, 2));
-    CHECK(child1.fv_from_fid(9) == Vector3l(5, 4, 2));
-    CHECK(child1.fv_from_fid(6) == Vector3l(3, 5, 0));
-    CHECK(child1.fv_from_fid(7) == Vector3l(3, 4, 5));
+    CHECK(child1.fv_from_fid(6) == Vector3l(0, 5, 2));
+    CHECK(child1.fv_from_fid(7) == Vector3l(5, 4, 2));
+    CHECK(child1.fv_from_fid(1) == Vector3l(3, 5, 0));
+    CHECK(child1.fv_from_fid(0) == Vector3l(3, 4, 5));
 
     CHECK(child2.fv_from_fid(2) == Vector3l(0, 2, 4));
     CHECK(child2.fv_from_fid(3) == Vector3l(7, 1, 2));
     CHECK(child2.fv_from_fid(5) == Vector3l(3, 5, 8));
-    CHECK(child2.fv_from_fid(7) == Vector3l(0, 9, 2));
-    CHECK(child2.fv_from_fid(8) == Vector3l(9, 7, 2));
-    CHECK(child2.fv_from_fid(9) == Vector3l(3, 10, 6));
-    CHECK(child2.fv_from_fid(10) == Vector3l(3, 8, 10));
+    CHECK(child2.fv_from_fid(1) == Vector3l(0, 9, 2));
+    CHECK(child2.fv_from_fid(0) == Vector3l(9, 7, 2));
+    CHECK(child2.fv_from_fid(7) == Vector3l(3, 10, 6));
+    CHECK(child2.fv_from_fid(8) == Vector3l(3, 8, 10));
 
     p_mul_manager.check_map_valid(parent);
 }
@@ -10,6 +10,7 @@
 #include <wmtk/invariants/TodoInvariant.hpp>
 #include <wmtk/io/Cache.hpp>
 #include <wmtk/io/ParaviewWriter.hpp>
+#include <wmtk/multimesh/consolidate.hpp>
 #include <wmtk/operations/EdgeCollapse.hpp>
 #include <wmtk/operations/EdgeSplit.hpp>
 #include <wmtk/operations/composite/TriEdgeSwap.hpp>
@@ -897,6 +898,132 @@ TEST_CASE("split_multiple_edges", "[operations][split][2D]")
     }
 }
 
+namespace {
+// rejects every operation after it was performed, so all its changes are rolled back
+class RejectAfterInvariant : public invariants::Invariant
+{
+public:
+    RejectAfterInvariant(const Mesh& m)
+        : Invariant(m, false, false, true)
+    {}
+    bool after(const std::vector<Tuple>&, const std::vector<Tuple>&) const override
+    {
+        return false;
+    }
+};
+} // namespace
+
+TEST_CASE("split_recycles_deleted_ids", "[operations][split][2D]")
+{
+    DEBUG_TriMesh mesh = edge_region();
+    const auto& free_ids = mesh.m_attribute_manager.m_free_ids;
+
+    // every deleted simplex below the capacity can be reused
+    auto check_free_ids = [&]() {
+        for (const PrimitiveType pt : {PV, PE, PF}) {
+            const int64_t dead = mesh.capacity(pt) - int64_t(mesh.get_all(pt).size());
+            CHECK(free_ids.size(get_primitive_type_id(pt)) == dead);
+        }
+    };
+
+    EdgeSplit split(mesh);
+    auto split_all = [&](EdgeSplit& op) {
+        for (const wmtk::Tuple& e : mesh.get_all(PE)) {
+            if (mesh.is_valid_slow(e)) {
+                op(Simplex::edge(e));
+            }
+        }
+        REQUIRE(mesh.is_connectivity_valid());
+    };
+
+    for (size_t i = 0; i < 3; ++i) {
+        split_all(split);
+        // a split deletes one edge and at most two faces, the next split reuses them
+        CHECK(mesh.capacity(PV) == mesh.get_all(PV).size());
+        CHECK(mesh.capacity(PE) - mesh.get_all(PE).size() <= 1);
+        CHECK(mesh.capacity(PF) - mesh.get_all(PF).size() <= 2);
+        check_free_ids();
+    }
+
+    // rolled back splits return the ids they took, including the ones past the capacity
+    EdgeSplit rejected_split(mesh);
+    rejected_split.add_invariant(std::make_shared<RejectAfterInvariant>(mesh));
+    const int64_t n_faces = mesh.get_all(PF).size();
+    split_all(rejected_split);
+    CHECK(mesh.get_all(PF).size() == n_faces);
+    check_free_ids();
+
+    split_all(split);
+    check_free_ids();
+
+    multimesh::consolidate(mesh);
+    CHECK(free_ids.size(get_primitive_type_id(PF)) == 0);
+    CHECK(mesh.capacity(PF) == mesh.get_all(PF).size());
+}
+
+TEST_CASE("split_grows_storage", "[operations][split][2D]")
+{
+    // no reservation ahead of the splits, the storage grows on demand
+    DEBUG_TriMesh mesh = edge_region();
+    EdgeSplit split(mesh);
+
+    int64_t n_splits = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        for (const wmtk::Tuple& e : mesh.get_all(PE)) {
+            if (mesh.is_valid_slow(e)) {
+                REQUIRE(!split(Simplex::edge(e)).empty());
+                ++n_splits;
+            }
+        }
+    }
+    REQUIRE(mesh.is_connectivity_valid());
+    CHECK(mesh.get_all(PV).size() == 10 + n_splits);
+
+    const std::vector<wmtk::attribute::StorageStats> stats = mesh.storage_stats();
+    REQUIRE(stats.size() == 3);
+    for (const PrimitiveType pt : {PV, PE, PF}) {
+        const wmtk::attribute::StorageStats& s = stats[get_primitive_type_id(pt)];
+        CHECK(s.live == mesh.get_all(pt).size());
+        CHECK(s.capacity == mesh.capacity(pt));
+        CHECK(s.live <= s.capacity);
+        CHECK(s.capacity <= s.reserved);
+        // the reservation at most doubles past what is needed
+        CHECK(s.reserved <= 2 * s.capacity);
+        CHECK(s.reserved <= s.peak_reserved);
+    }
+
+    multimesh::consolidate(mesh);
+    const std::vector<wmtk::attribute::StorageStats> consolidated = mesh.storage_stats();
+    for (const PrimitiveType pt : {PV, PE, PF}) {
+        const int64_t d = get_primitive_type_id(pt);
+        CHECK(consolidated[d].live == stats[d].live);
+        CHECK(consolidated[d].capacity == consolidated[d].live);
+        CHECK(consolidated[d].peak_reserved == stats[d].peak_reserved);
+    }
+}
+
+TEST_CASE("split_storage_accessed_concurrently", "[operations][split][2D]")
+{
+    DEBUG_TriMesh mesh = edge_region();
+    // nothing is reserved past the current vertices
+    REQUIRE(mesh.storage_stats()[0].reserved == mesh.capacity(PV));
+    EdgeSplit split(mesh);
+    const Tuple edge = mesh.edge_tuple_between_v1_v2(4, 5, 2);
+
+    // other threads might be reading the attributes, the split must not reallocate them
+    mesh.set_accessed_concurrently(true);
+    CHECK_THROWS(split(Simplex::edge(edge)));
+    mesh.set_accessed_concurrently(false);
+
+    // the scope left by the exception was rolled back
+    CHECK(mesh.is_connectivity_valid());
+    CHECK(mesh.get_all(PV).size() == 10);
+    CHECK(mesh.is_valid_slow(edge));
+
+    CHECK(!split(Simplex::edge(edge)).empty());
+    CHECK(mesh.get_all(PV).size() == 11);
+}
+
 TEST_CASE("split_modified_primitives", "[operations][split]")
 {
     DEBUG_TriMesh m = edge_region();
@@ -9,11 +9,16 @@
 
 #include <wmtk/EdgeMesh.hpp>
 #include <wmtk/attribute/TypedAttributeHandle.hpp>
+#include <wmtk/envelope/EnvelopeIndex.hpp>
+#include <wmtk/invariants/EnvelopeInvariant.hpp>
 #include <wmtk/invariants/MinIncidentValenceInvariant.hpp>
 #include <wmtk/invariants/MultiMeshTopologyInvariant.hpp>
 #include <wmtk/invariants/TetMeshSubstructureTopologyPreservingInvariant.hpp>
 #include <wmtk/invariants/TriMeshSubstructureTopologyPreservingInvariant.hpp>
 #include <wmtk/multimesh/utils/extract_child_mesh_from_tag.hpp>
+#include <wmtk/simplex/faces_single_dimension.hpp>
+
+#include <fastenvelope/FastEnvelope.h>
 
 using namespace wmtk;
 using namespace wmtk::simplex;
@@ -773,4 +778,45 @@ TEST_CASE("SubstructureTopologyPreservingInvariant_in_2_by_2_by_2_tet", "[invari
 
         // CHECK_FALSE(inv.before(Simplex::edge(m.edge_tuple_between_v1_v2(12, 13, 30))));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("EnvelopeInvariant", "[invariants][envelope][2D]")
+{
+    TriMesh m = ten_triangles_with_position(3);
+    const auto pos_handle = m.get_attribute_handle<double>("vertices", PrimitiveType::Vertex);
+    const double envelope_size = 1e-3;
+
+    const auto index = std::make_shared<envelope::EnvelopeIndex>(pos_handle);
+    const EnvelopeInvariant inv(index, envelope_size, pos_handle);
+    const auto fast_envelope = index->fast_envelope(envelope_size);
+
+    auto pos = m.create_accessor<double>(pos_handle);
+    const std::vector<Tuple> faces = m.get_all(PrimitiveType::Triangle);
+
+    // the per triangle path the invariant is checked against
+    auto any_triangle_outside = [&]() {
+        for (const Tuple& f : faces) {
+            const std::vector<Tuple> fv = faces_single_dimension_tuples(
+                m,
+                Simplex::face(f),
+                PrimitiveType::Vertex);
+            std::array<Eigen::Vector3d, 3> triangle;
+            for (size_t j = 0; j < 3; ++j) {
+                triangle[j] = pos.const_vector_attribute(fv[j]);
+            }
+            if (fast_envelope->is_outside(triangle)) return true;
+        }
+        return false;
+    };
+
+    CHECK_FALSE(any_triangle_outside());
+    CHECK(inv.after({}, faces));
+
+    for (const Tuple& v : m.get_all(PrimitiveType::Vertex)) {
+        pos.vector_attribute(v)[2] += 0.5;
+        CHECK(any_triangle_outside());
+        CHECK_FALSE(inv.after({}, faces));
+        pos.vector_attribute(v)[2] -= 0.5;
+    }
+    CHECK(inv.after({}, faces));
+}
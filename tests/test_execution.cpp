@@ -1,7 +1,9 @@
 #include <array>
+#include <limits>
 #include <catch2/catch_test_macros.hpp>
 #include <wmtk/Scheduler.hpp>
 #include <wmtk/invariants/InteriorVertexInvariant.hpp>
+#include <wmtk/invariants/MultiMeshLinkConditionInvariant.hpp>
 #include <wmtk/operations/AttributesUpdate.hpp>
 #include <wmtk/operations/EdgeCollapse.hpp>
 #include <wmtk/operations/EdgeSplit.hpp>
@@ -129,3 +131,187 @@ TEST_CASE("scheduler_success_report", "[scheduler][operations][2D][.]")
         }
     }
 }
+
+TEST_CASE("scheduler_parallel_independent_sets", "[scheduler][operations][2D]")
+{
+    using namespace operations;
+
+    DEBUG_TriMesh m = edge_region();
+    const int64_t n_edges = m.get_all(PrimitiveType::Edge).size();
+    const int64_t n_faces = m.get_all(PrimitiveType::Triangle).size();
+
+    Scheduler scheduler;
+    scheduler.set_number_of_threads(4);
+    CHECK(scheduler.number_of_threads() == 4);
+
+    EdgeSplit op(m);
+    const SchedulerStats res = scheduler.run_operation_on_all(op);
+
+    CHECK(m.is_connectivity_valid());
+    CHECK(res.number_of_performed_operations() == n_edges);
+    CHECK(res.number_of_successful_operations() > 0);
+    CHECK(res.number_of_rounds() > 1);
+    CHECK(res.number_of_conflicts() > 0);
+    CHECK(res.number_of_retries() == 0);
+    CHECK(m.get_all(PrimitiveType::Triangle).size() > n_faces);
+
+    CHECK(!res.per_thread_executing_time.empty());
+    for (const double t : res.per_thread_executing_time) {
+        CHECK(t >= 0);
+    }
+    CHECK(scheduler.stats().number_of_conflicts() == res.number_of_conflicts());
+}
+
+TEST_CASE("scheduler_parallel_matches_serial", "[scheduler][operations][2D]")
+{
+    using namespace operations;
+
+    SECTION("order_independent")
+    {
+        // every vertex counts its visits, the result does not depend on the order
+        auto run = [](int64_t num_threads) {
+            DEBUG_TriMesh m = edge_region();
+            auto visits_handle = m.register_attribute<int64_t>("visits", PrimitiveType::Vertex, 1);
+
+            AttributesUpdateWithFunction op(m);
+            op.set_function([visits_handle](Mesh& mesh, const simplex::Simplex& s) {
+                auto visits = mesh.create_accessor<int64_t>(visits_handle);
+                ++visits.scalar_attribute(s.tuple());
+                return true;
+            });
+
+            Scheduler scheduler;
+            scheduler.set_number_of_threads(num_threads);
+            const SchedulerStats res = scheduler.run_operation_on_all(op);
+
+            const int64_t n_vertices = m.get_all(PrimitiveType::Vertex).size();
+            CHECK(res.number_of_performed_operations() == n_vertices);
+            CHECK(res.number_of_successful_operations() == n_vertices);
+            CHECK(res.number_of_failed_operations() == 0);
+
+            auto visits = m.create_accessor<int64_t>(visits_handle);
+            for (const Tuple& v : m.get_all(PrimitiveType::Vertex)) {
+                CHECK(visits.scalar_attribute(v) == 1);
+            }
+            CHECK(m.is_connectivity_valid());
+            return res;
+        };
+
+        const SchedulerStats serial = run(1);
+        const SchedulerStats parallel = run(4);
+        CHECK(parallel.number_of_rounds() > 1);
+        CHECK(
+            serial.number_of_successful_operations() ==
+            parallel.number_of_successful_operations());
+    }
+    SECTION("split")
+    {
+        // a split adds one vertex and one more edge than faces, whatever the order
+        for (const int64_t num_threads : {1, 4}) {
+            DEBUG_TriMesh m = edge_region();
+            const int64_t n_vertices = m.get_all(PrimitiveType::Vertex).size();
+            const int64_t n_edges = m.get_all(PrimitiveType::Edge).size();
+            const int64_t n_faces = m.get_all(PrimitiveType::Triangle).size();
+
+            EdgeSplit op(m);
+            Scheduler scheduler;
+            scheduler.set_number_of_threads(num_threads);
+            const SchedulerStats res = scheduler.run_operation_on_all(op);
+
+            const int64_t n_splits = res.number_of_successful_operations();
+            CHECK(res.number_of_performed_operations() == n_edges);
+            CHECK(n_splits > 0);
+            CHECK(m.is_connectivity_valid());
+            CHECK(m.get_all(PrimitiveType::Vertex).size() == n_vertices + n_splits);
+            CHECK(
+                int64_t(m.get_all(PrimitiveType::Edge).size()) -
+                    int64_t(m.get_all(PrimitiveType::Triangle).size()) ==
+                n_edges - n_faces + n_splits);
+        }
+    }
+}
+
+TEST_CASE("operation_priority_key", "[scheduler][operations]")
+{
+    using namespace operations;
+
+    const std::vector<std::vector<double>> values = {{1}, {1, 2}, {1, 3}, {0, 5}, {2}, {}};
+    for (const auto& a : values) {
+        for (const auto& b : values) {
+            CHECK((PriorityKey::from_vector(a) < PriorityKey::from_vector(b)) == (a < b));
+            CHECK((PriorityKey::from_vector(a) == PriorityKey::from_vector(b)) == (a == b));
+        }
+        CHECK(PriorityKey::from_vector(a).to_vector() == a);
+    }
+    CHECK_THROWS(PriorityKey::from_vector({1, 2, 3, 4, 5}));
+
+    DEBUG_TriMesh m = single_triangle();
+    EdgeSplit op(m);
+    const simplex::Simplex e = simplex::Simplex::edge(m.get_all(PrimitiveType::Edge)[0]);
+    CHECK(op.priority(e) == PriorityKey(0));
+
+    // legacy priorities go through the adapter
+    op.set_priority([](const simplex::Simplex&) { return std::vector<double>({3, -1}); });
+    CHECK(op.priority(e) == PriorityKey({3, -1}));
+
+    op.set_priority([](const simplex::Simplex&) { return 2.; });
+    CHECK(op.priority(e) == PriorityKey(2));
+
+    Scheduler scheduler;
+    const SchedulerStats res = scheduler.run_operation_on_all(op);
+    CHECK(res.number_of_successful_operations() == 1);
+}
+
+TEST_CASE("scheduler_until_convergence", "[scheduler][operations][2D]")
+{
+    using namespace operations;
+
+    SECTION("bounded_split")
+    {
+        DEBUG_TriMesh m = single_triangle();
+        EdgeSplit op(m);
+
+        Scheduler scheduler;
+        const SchedulerStats res = scheduler.run_operation_until_convergence(op, 5);
+        CHECK(res.number_of_successful_operations() == 5);
+        CHECK(res.number_of_requeued_simplices() > 0);
+        CHECK(m.is_connectivity_valid());
+        // new edges are processed in the same run
+        CHECK(m.get_all(PrimitiveType::Triangle).size() > 3);
+    }
+    SECTION("collapse")
+    {
+        DEBUG_TriMesh m = edge_region();
+        EdgeCollapse op(m);
+        op.add_invariant(std::make_shared<MultiMeshLinkConditionInvariant>(m));
+
+        Scheduler scheduler;
+        const SchedulerStats res = scheduler.run_operation_until_convergence(op);
+        CHECK(res.number_of_successful_operations() > 0);
+        CHECK(m.is_connectivity_valid());
+
+        // a sweep after convergence finds nothing left to do
+        const SchedulerStats sweep = scheduler.run_operation_on_all(op);
+        CHECK(sweep.number_of_successful_operations() == 0);
+    }
+    SECTION("nan_priority")
+    {
+        // e.g. the length of a degenerate edge, must neither requeue forever nor break the heap
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        CHECK(PriorityKey({1, nan}) == PriorityKey({1, nan}));
+        CHECK(PriorityKey({1, 2}) < PriorityKey({1, nan}));
+        CHECK_FALSE(PriorityKey({1, nan}) < PriorityKey({1, nan}));
+        CHECK_FALSE(PriorityKey(nan) < PriorityKey(0));
+
+        DEBUG_TriMesh m = edge_region();
+        EdgeSplit op(m);
+        op.set_priority([](const simplex::Simplex&) {
+            return std::numeric_limits<double>::quiet_NaN();
+        });
+
+        Scheduler scheduler;
+        const SchedulerStats res = scheduler.run_operation_until_convergence(op, 10);
+        CHECK(res.number_of_successful_operations() == 10);
+        CHECK(m.is_connectivity_valid());
+    }
+}
@@ -123,6 +123,59 @@ TEST_CASE("accessor_performance", "[accessor][performance][.]")
     //}
 }
 
+TEST_CASE("cached_accessor_performance", "[accessor][performance][.]")
+{
+    const std::filesystem::path meshfile = data_dir / "armadillo.msh";
+
+    auto mesh_in = wmtk::read_mesh(meshfile);
+    Mesh& m = *mesh_in;
+
+    auto pos_handle = m.get_attribute_handle<double>("vertices", PrimitiveType::Vertex);
+
+    const size_t n_repetitions = 100;
+
+    const auto edges = m.get_all(PrimitiveType::Edge);
+
+    // what every invariant and function used to do: one accessor per evaluation
+    {
+        POLYSOLVE_SCOPED_STOPWATCH("Accessor per call", logger());
+        double sum = 0;
+        for (size_t i = 0; i < n_repetitions; ++i) {
+            for (const Tuple& t : edges) {
+                const attribute::Accessor<double> acc = m.create_const_accessor<double>(pos_handle);
+                sum += acc.const_vector_attribute(t)[0];
+            }
+        }
+        std::cout << "sum = " << sum << std::endl;
+    }
+
+    const attribute::Accessor<double> pos_acc = m.create_const_accessor<double>(pos_handle);
+    {
+        POLYSOLVE_SCOPED_STOPWATCH("Cached accessor", logger());
+        double sum = 0;
+        for (size_t i = 0; i < n_repetitions; ++i) {
+            for (const Tuple& t : edges) {
+                sum += pos_acc.const_vector_attribute(t)[0];
+            }
+        }
+        std::cout << "sum = " << sum << std::endl;
+    }
+
+    // switch_tuple reads the cell hash through the accessor owned by the mesh
+    {
+        POLYSOLVE_SCOPED_STOPWATCH("switch_tuple", logger());
+        int64_t sum = 0;
+        for (size_t i = 0; i < n_repetitions; ++i) {
+            for (const Tuple& t : edges) {
+                if (!m.is_boundary(PrimitiveType::Edge, t)) {
+                    sum += m.is_ccw(m.switch_tuple(t, m.top_simplex_type()));
+                }
+            }
+        }
+        std::cout << "sum = " << sum << std::endl;
+    }
+}
+
 TEST_CASE("split_with_attributes", "[performance][.]")
 {
     using namespace operations;
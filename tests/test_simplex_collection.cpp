@@ -683,6 +683,83 @@ TEST_CASE("simplex_top_dimension_cofaces_tet", "[simplex_collection]")
     }
 }
 
+namespace {
+// compares the buffer version of top_dimension_cofaces_tuples against a brute force search over
+// all top simplices
+template <typename MeshType>
+void check_top_dimension_cofaces_buffer(const MeshType& m)
+{
+    const PrimitiveType top_type = m.top_simplex_type();
+    const std::vector<Tuple> cells = m.get_all(top_type);
+
+    TopDimensionCofacesBuffer buffer;
+    for (const PrimitiveType pt : wmtk::utils::primitive_below(top_type)) {
+        for (const Tuple& t : m.get_all(pt)) {
+            const Simplex s(pt, t);
+
+            SimplexCollection expected(m);
+            for (const Tuple& c : cells) {
+                if (pt == top_type) {
+                    if (simplex::utils::SimplexComparisons::equal(m, s, Simplex(pt, c))) {
+                        expected.add(top_type, c);
+                    }
+                    continue;
+                }
+                for (const Tuple& f :
+                     faces_single_dimension_tuples(m, Simplex(top_type, c), pt)) {
+                    if (simplex::utils::SimplexComparisons::equal(m, s, Simplex(pt, f))) {
+                        expected.add(top_type, c);
+                    }
+                }
+            }
+            expected.sort_and_clean();
+
+            buffer.clear();
+            top_dimension_cofaces_tuples(m, s, buffer);
+            CHECK(buffer.is_inline());
+            CHECK(buffer.size() == expected.simplex_vector().size());
+
+            SimplexCollection result(m);
+            for (const Tuple& c : buffer) {
+                check_match_below_simplex_type(m, s, Simplex(top_type, c));
+                result.add(top_type, c);
+            }
+            result.sort_and_clean();
+            CHECK(SimplexCollection::are_simplex_collections_equal(expected, result));
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("simplex_top_dimension_cofaces_buffer", "[simplex_collection]")
+{
+    SECTION("hex_plus_two")
+    {
+        const tests::DEBUG_TriMesh m = tests::hex_plus_two();
+        check_top_dimension_cofaces_buffer(m);
+    }
+    SECTION("closed_surface")
+    {
+        const tests::DEBUG_TriMesh m = tests::tetrahedron();
+        check_top_dimension_cofaces_buffer(m);
+    }
+    SECTION("surface_with_hole")
+    {
+        const tests::DEBUG_TriMesh m = tests::nine_triangles_with_a_hole();
+        check_top_dimension_cofaces_buffer(m);
+    }
+    SECTION("six_cycle_tets")
+    {
+        const tests_3d::DEBUG_TetMesh m = tests_3d::six_cycle_tets();
+        check_top_dimension_cofaces_buffer(m);
+    }
+    SECTION("two_by_two_by_two_grids_tets")
+    {
+        const tests_3d::DEBUG_TetMesh m = tests_3d::two_by_two_by_two_grids_tets();
+        check_top_dimension_cofaces_buffer(m);
+    }
+}
+
 TEST_CASE("simplex_top_dimension_cofaces_iterable", "[simplex_collection][2D]")
 {
     tests::DEBUG_TriMesh m = tests::hex_plus_two();
@@ -1,6 +1,10 @@
 #include "tools/DEBUG_TetMesh.hpp"
 #include "tools/DEBUG_TriMesh.hpp"
+#include "tools/TetMesh_examples.hpp"
+#include "tools/TriMesh_examples.hpp"
 
+#include <wmtk/autogen/tet_mesh/autogenerated_tables.hpp>
+#include <wmtk/autogen/tri_mesh/autogenerated_tables.hpp>
 #include <wmtk/utils/edgemesh_topology_initialization.h>
 #include <wmtk/utils/tetmesh_topology_initialization.h>
 #include <wmtk/utils/trimesh_topology_initialization.h>
@@ -11,7 +15,10 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <stdlib.h>
+#include <algorithm>
 #include <iostream>
+#include <numeric>
+#include <random>
 
 #include <wmtk/utils/Logger.hpp>
 
@@ -428,3 +435,274 @@ TEST_CASE("topology_test_1d", "[topology][1D]")
         }
     }
 }
+
+namespace {
+// the sequential initialization with one heap vector per record, as it was before the flat
+// records, to check that the output did not change
+std::tuple<RowVectors3l, RowVectors3l, VectorXl, VectorXl> reference_trimesh_topology_initialization(
+    Eigen::Ref<const RowVectors3l> F)
+{
+    RowVectors3l FE, FF;
+    VectorXl VF, EF;
+    std::vector<std::vector<int64_t>> TTT(F.rows() * 3);
+    for (int64_t t = 0; t < F.rows(); ++t) {
+        for (int64_t i = 0; i < 3; ++i) {
+            int64_t x = F(t, wmtk::autogen::tri_mesh::auto_2d_edges[i][0]);
+            int64_t y = F(t, wmtk::autogen::tri_mesh::auto_2d_edges[i][1]);
+            if (x > y) std::swap(x, y);
+            TTT[t * 3 + i] = {x, y, t, i};
+        }
+    }
+    std::sort(TTT.begin(), TTT.end());
+
+    VF = VectorXl::Constant(F.maxCoeff() + 1, 1, -1);
+    for (int64_t i = 0; i < F.rows(); ++i) {
+        for (int64_t j = 0; j < 3; ++j) {
+            VF[F(i, j)] = i;
+        }
+    }
+
+    FE.resize(F.rows(), 3);
+    FF.resize(F.rows(), 3);
+    std::vector<int64_t> EF_temp;
+    for (size_t i = 0; i < TTT.size(); ++i) {
+        if ((i == TTT.size() - 1) || (TTT[i][0] != TTT[i + 1][0]) ||
+            (TTT[i][1] != TTT[i + 1][1])) {
+            EF_temp.push_back(TTT[i][2]);
+            FF(TTT[i][2], TTT[i][3]) = -1;
+            FE(TTT[i][2], TTT[i][3]) = EF_temp.size() - 1;
+        } else {
+            EF_temp.push_back(TTT[i][2]);
+            FF(TTT[i][2], TTT[i][3]) = TTT[i + 1][2];
+            FE(TTT[i][2], TTT[i][3]) = EF_temp.size() - 1;
+            FF(TTT[i + 1][2], TTT[i + 1][3]) = TTT[i][2];
+            FE(TTT[i + 1][2], TTT[i + 1][3]) = EF_temp.size() - 1;
+            ++i;
+        }
+    }
+    EF = Eigen::Map<VectorXl>(EF_temp.data(), EF_temp.size());
+
+    return {FE, FF, VF, EF};
+}
+
+std::tuple<RowVectors6l, RowVectors4l, RowVectors4l, VectorXl, VectorXl, VectorXl>
+reference_tetmesh_topology_initialization(Eigen::Ref<const RowVectors4l> T)
+{
+    RowVectors6l TE;
+    RowVectors4l TF;
+    RowVectors4l TT;
+    VectorXl FT;
+    VectorXl ET;
+    VectorXl VT;
+    std::vector<std::vector<int64_t>> TTT(T.rows() * 4);
+    for (int64_t t = 0; t < T.rows(); ++t) {
+        for (int64_t i = 0; i < 4; ++i) {
+            int64_t x = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_faces[i][0]));
+            int64_t y = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_faces[i][1]));
+            int64_t z = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_faces[i][2]));
+            if (x > y) std::swap(x, y);
+            if (y > z) std::swap(y, z);
+            if (x > y) std::swap(x, y);
+            TTT[t * 4 + i] = {x, y, z, t, i};
+        }
+    }
+    std::sort(TTT.begin(), TTT.end());
+
+    // the unused entries of VT were left uninitialized
+    VT = VectorXl::Constant(T.maxCoeff() + 1, 1, -1);
+    for (int64_t i = 0; i < T.rows(); ++i) {
+        for (int64_t j = 0; j < T.cols(); ++j) {
+            VT[T(i, j)] = i;
+        }
+    }
+
+    TF.resize(T.rows(), 4);
+    TT.resize(T.rows(), 4);
+    std::vector<int64_t> FT_temp;
+    for (size_t i = 0; i < TTT.size(); ++i) {
+        if ((i == TTT.size() - 1) || (TTT[i][0] != TTT[i + 1][0]) ||
+            (TTT[i][1] != TTT[i + 1][1]) || (TTT[i][2] != TTT[i + 1][2])) {
+            FT_temp.push_back(TTT[i][3]);
+            TT(TTT[i][3], TTT[i][4]) = -1;
+            TF(TTT[i][3], TTT[i][4]) = FT_temp.size() - 1;
+        } else {
+            FT_temp.push_back(TTT[i][3]);
+            TT(TTT[i][3], TTT[i][4]) = TTT[i + 1][3];
+            TF(TTT[i][3], TTT[i][4]) = FT_temp.size() - 1;
+            TT(TTT[i + 1][3], TTT[i + 1][4]) = TTT[i][3];
+            TF(TTT[i + 1][3], TTT[i + 1][4]) = FT_temp.size() - 1;
+            ++i;
+        }
+    }
+    FT = Eigen::Map<VectorXl>(FT_temp.data(), FT_temp.size());
+
+    TTT.resize(T.rows() * 6);
+    for (int64_t t = 0; t < T.rows(); ++t) {
+        for (int64_t i = 0; i < 6; ++i) {
+            int64_t x = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_edges[i][0]));
+            int64_t y = T(t, static_cast<int64_t>(autogen::tet_mesh::auto_3d_edges[i][1]));
+            if (x > y) std::swap(x, y);
+            TTT[t * 6 + i] = {x, y, 0, t, i};
+        }
+    }
+    std::sort(TTT.begin(), TTT.end());
+
+    TE.resize(T.rows(), 6);
+    std::vector<int64_t> ET_temp;
+    for (size_t i = 0; i < TTT.size(); ++i) {
+        ET_temp.push_back(TTT[i][3]);
+        size_t j = i;
+        while (j < TTT.size() && TTT[i][0] == TTT[j][0] && TTT[i][1] == TTT[j][1]) {
+            TE(TTT[j][3], TTT[j][4]) = ET_temp.size() - 1;
+            ++j;
+        }
+        i = j - 1;
+    }
+    ET = Eigen::Map<VectorXl>(ET_temp.data(), ET_temp.size());
+
+    return {TE, TF, TT, VT, ET, FT};
+}
+
+void check_same_topology(const RowVectors3l& F)
+{
+    const auto [FE, FF, VF, EF] = trimesh_topology_initialization(F);
+    const auto [FE_ref, FF_ref, VF_ref, EF_ref] = reference_trimesh_topology_initialization(F);
+    CHECK(FE == FE_ref);
+    CHECK(FF == FF_ref);
+    CHECK(VF == VF_ref);
+    CHECK(EF == EF_ref);
+}
+
+void check_same_topology(const RowVectors4l& T)
+{
+    const auto [TE, TF, TT, VT, ET, FT] = tetmesh_topology_initialization(T);
+    const auto [TE_ref, TF_ref, TT_ref, VT_ref, ET_ref, FT_ref] =
+        reference_tetmesh_topology_initialization(T);
+    CHECK(TE == TE_ref);
+    CHECK(TF == TF_ref);
+    CHECK(TT == TT_ref);
+    CHECK(VT == VT_ref);
+    CHECK(ET == ET_ref);
+    CHECK(FT == FT_ref);
+}
+
+template <typename Matrix>
+Matrix shuffled_rows(const Matrix& M, std::mt19937& gen)
+{
+    std::vector<int64_t> order(M.rows());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), gen);
+    Matrix res(M.rows(), M.cols());
+    for (int64_t i = 0; i < M.rows(); ++i) res.row(i) = M.row(order[i]);
+    return res;
+}
+} // namespace
+
+TEST_CASE("topology_initialization_matches_reference_2d", "[topology][2D]")
+{
+    SECTION("examples")
+    {
+        for (const tests::DEBUG_TriMesh& m :
+             {tests::DEBUG_TriMesh(tests::single_triangle()),
+              tests::DEBUG_TriMesh(tests::quad()),
+              tests::DEBUG_TriMesh(tests::two_neighbors_cut_on_edge01()),
+              tests::DEBUG_TriMesh(tests::tetrahedron()),
+              tests::DEBUG_TriMesh(tests::hex_plus_two()),
+              tests::DEBUG_TriMesh(tests::edge_region()),
+              tests::DEBUG_TriMesh(tests::three_triangles_with_two_components()),
+              tests::DEBUG_TriMesh(tests::nine_triangles_with_a_hole()),
+              tests::DEBUG_TriMesh(tests::embedded_diamond()),
+              tests::DEBUG_TriMesh(tests::three_individuals())}) {
+            const int64_t n = m.get_all(PrimitiveType::Triangle).size();
+            RowVectors3l F(n, 3);
+            for (int64_t f = 0; f < n; ++f) {
+                F.row(f) = m.fv_from_fid(f).transpose();
+            }
+            check_same_topology(F);
+        }
+    }
+    SECTION("non_manifold")
+    {
+        // three triangles on the edge 0 1
+        RowVectors3l F(3, 3);
+        F << 0, 1, 2, 1, 0, 3, 0, 1, 4;
+        check_same_topology(F);
+    }
+    SECTION("shuffled_grid")
+    {
+        // large enough to be split between threads
+        const int64_t n = 100;
+        RowVectors3l F(2 * n * n, 3);
+        for (int64_t i = 0; i < n; ++i) {
+            for (int64_t j = 0; j < n; ++j) {
+                const int64_t v = i * (n + 1) + j;
+                F.row(2 * (i * n + j)) << v, v + 1, v + n + 2;
+                F.row(2 * (i * n + j) + 1) << v, v + n + 2, v + n + 1;
+            }
+        }
+        std::mt19937 gen(3);
+        check_same_topology(F);
+        check_same_topology(shuffled_rows(F, gen));
+    }
+}
+
+TEST_CASE("topology_initialization_matches_reference_3d", "[topology][3D]")
+{
+    SECTION("examples")
+    {
+        for (const tests_3d::DEBUG_TetMesh& m :
+             {tests_3d::DEBUG_TetMesh(tests_3d::single_tet()),
+              tests_3d::DEBUG_TetMesh(tests_3d::one_ear()),
+              tests_3d::DEBUG_TetMesh(tests_3d::two_ears()),
+              tests_3d::DEBUG_TetMesh(tests_3d::three_incident_tets()),
+              tests_3d::DEBUG_TetMesh(tests_3d::six_cycle_tets()),
+              tests_3d::DEBUG_TetMesh(tests_3d::three_cycle_tets()),
+              tests_3d::DEBUG_TetMesh(tests_3d::four_cycle_tets()),
+              tests_3d::DEBUG_TetMesh(tests_3d::two_by_three_grids_tets()),
+              tests_3d::DEBUG_TetMesh(tests_3d::two_by_two_by_two_grids_tets())}) {
+            const int64_t n = m.get_all(PrimitiveType::Tetrahedron).size();
+            RowVectors4l T(n, 4);
+            for (int64_t t = 0; t < n; ++t) {
+                T.row(t) = m.tv_from_tid(t).transpose();
+            }
+            check_same_topology(T);
+        }
+    }
+    SECTION("non_manifold")
+    {
+        // three tets on the face 0 1 2
+        RowVectors4l T(3, 4);
+        T << 0, 1, 2, 3, 1, 0, 2, 4, 0, 1, 2, 5;
+        check_same_topology(T);
+    }
+    SECTION("shuffled_grid")
+    {
+        // every cube split into the 6 tets along its diagonal
+        const int64_t n = 16;
+        auto vid = [n](int64_t i, int64_t j, int64_t k) {
+            return (i * (n + 1) + j) * (n + 1) + k;
+        };
+        const std::array<std::array<int64_t, 3>, 6> axes = {
+            {{{0, 1, 2}}, {{0, 2, 1}}, {{1, 0, 2}}, {{1, 2, 0}}, {{2, 0, 1}}, {{2, 1, 0}}}};
+        RowVectors4l T(6 * n * n * n, 4);
+        int64_t t = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            for (int64_t j = 0; j < n; ++j) {
+                for (int64_t k = 0; k < n; ++k) {
+                    for (const auto& a : axes) {
+                        std::array<int64_t, 3> c = {{i, j, k}};
+                        T(t, 0) = vid(c[0], c[1], c[2]);
+                        for (int64_t l = 0; l < 3; ++l) {
+                            ++c[a[l]];
+                            T(t, l + 1) = vid(c[0], c[1], c[2]);
+                        }
+                        ++t;
+                    }
+                }
+            }
+        }
+        std::mt19937 gen(4);
+        check_same_topology(T);
+        check_same_topology(shuffled_rows(T, gen));
+    }
+}
@@ -2,7 +2,10 @@
 #include <wmtk/utils/trimesh_topology_initialization.h>
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
+#include <wmtk/PackedTuple.hpp>
 #include <wmtk/Tuple.hpp>
+#include "tools/TetMesh_examples.hpp"
+#include "tools/TriMesh_examples.hpp"
 
 using namespace wmtk;
 
@@ -63,3 +66,42 @@ TEST_CASE("tuple_comparison", "[tuple]")
     CHECK(a.same_ids(b));
 }
 }
+
+TEST_CASE("packed_tuple", "[tuple]")
+{
+    static_assert(sizeof(PackedTuple) == 8);
+
+    CHECK(PackedTuple().unpack().is_null());
+    CHECK(PackedTuple(Tuple()) == PackedTuple());
+
+    for (const int64_t cid : {int64_t(-1), int64_t(0), int64_t(1), PackedTuple::max_global_cid}) {
+        for (int8_t vid = -1; vid < 4; ++vid) {
+            for (int8_t eid = -1; eid < 6; ++eid) {
+                for (int8_t fid = -1; fid < 4; ++fid) {
+                    for (const int8_t hash : {-128, -1, 0, 1, 127}) {
+                        const Tuple t(vid, eid, fid, cid, hash);
+                        CHECK(PackedTuple(t).unpack() == t);
+                    }
+                }
+            }
+        }
+    }
+
+    // packed tuples sort by cell first
+    CHECK(PackedTuple(Tuple(3, 5, 3, 0, 127)) < PackedTuple(Tuple(0, 0, 0, 1, 0)));
+    CHECK(PackedTuple(Tuple(-1, -1, -1, -1, -1)) < PackedTuple(Tuple(0, 0, 0, 0, 0)));
+
+    SECTION("get_all")
+    {
+        const TetMesh tm = tests_3d::six_cycle_tets();
+        const TriMesh fm = tests::edge_region();
+        for (const Mesh* m : std::initializer_list<const Mesh*>{&tm, &fm}) {
+            for (int64_t d = 0; d <= m->top_cell_dimension(); ++d) {
+                const PrimitiveType pt = get_primitive_type_from_id(d);
+                const std::vector<Tuple> tuples = m->get_all(pt);
+                CHECK(m->get_all_packed(pt) == pack_tuples(tuples));
+                CHECK(unpack_tuples(pack_tuples(tuples)) == tuples);
+            }
+        }
+    }
+}
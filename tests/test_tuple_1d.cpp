@@ -75,7 +75,7 @@ TEST_CASE("1D_initialize", "[mesh_creation],[tuple_1d]")
         REQUIRE(m.is_connectivity_valid());
     }
 
-    auto const_hash_accessor = m.get_const_cell_hash_accessor();
+    const auto& const_hash_accessor = m.get_const_cell_hash_accessor();
     for (size_t i = 0; i < edges.size(); ++i) {
         REQUIRE(m.is_valid(edges[i], const_hash_accessor));
     }
@@ -168,7 +168,7 @@ TEST_CASE("1D_self_loop", "[tuple_generation], [tuple_1d]")
 TEST_CASE("1D_random_switches", "[tuple_operation],[tuple_1d]")
 {
     DEBUG_EdgeMesh m = loop_lines();
-    const attribute::Accessor<int64_t> hash_accessor = m.get_const_cell_hash_accessor();
+    const attribute::Accessor<int64_t>& hash_accessor = m.get_const_cell_hash_accessor();
     SECTION("vertices")
     {
         const std::vector<Tuple> vertex_tuples = m.get_all(PrimitiveType::Vertex);
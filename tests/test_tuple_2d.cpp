@@ -3,6 +3,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
 #include <wmtk/TriMesh.hpp>
+#include <wmtk/operations/EdgeSplit.hpp>
 #include <wmtk/utils/Logger.hpp>
 #include "tools/DEBUG_TriMesh.hpp"
 #include "tools/TriMesh_examples.hpp"
@@ -392,3 +393,59 @@ TEST_CASE("2D_is_boundary", "[tuple_2d]")
     CHECK(!m.is_boundary_edge(t3));
     CHECK(!m.is_boundary_vertex(t3));
 }
+
+TEST_CASE("2D_valid_current", "[tuple_2d]")
+{
+    DEBUG_TriMesh m = edge_region();
+    const std::vector<Tuple> faces = m.get_all(PrimitiveType::Triangle);
+    std::vector<Tuple> tuples;
+    for (const Tuple& f : faces) {
+        tuples.emplace_back(f);
+        tuples.emplace_back(m.switch_tuple(f, PrimitiveType::Vertex));
+    }
+    for (const Tuple& t : tuples) {
+        CHECK(m.is_valid_current(t));
+    }
+    CHECK(!m.is_valid_current(Tuple()));
+
+    // a failed operation rolls the hashes back
+    {
+        auto scope = m.create_scope();
+        operations::EdgeSplit split(m);
+        REQUIRE(!split(simplex::Simplex::edge(m.edge_tuple_between_v1_v2(4, 5, 2))).empty());
+        scope.mark_failed();
+    }
+    std::vector<Tuple> copy = tuples;
+    CHECK(m.validate_tuples(copy) == 0);
+    CHECK(copy == tuples);
+
+    operations::EdgeSplit split(m);
+    REQUIRE(!split(simplex::Simplex::edge(m.edge_tuple_between_v1_v2(4, 5, 2))).empty());
+
+    std::vector<Tuple> valid;
+    std::vector<Tuple> alive;
+    for (const Tuple& t : tuples) {
+        CHECK(m.is_valid_current(t) == m.is_valid_slow(t));
+        if (m.is_valid_slow(t)) {
+            valid.emplace_back(t);
+        }
+        if (m.id(t, PrimitiveType::Triangle) != 2 && m.id(t, PrimitiveType::Triangle) != 7) {
+            alive.emplace_back(t);
+        }
+    }
+    // the split rehashes every cell around the vertices of the edge
+    REQUIRE(valid.size() < alive.size());
+
+    copy = tuples;
+    CHECK(m.validate_tuples(copy) == 0);
+    CHECK(copy == valid);
+
+    // the cells that were only rehashed keep their connectivity, the deleted ones are dropped
+    copy = tuples;
+    CHECK(m.validate_tuples(copy, true) == int64_t(alive.size() - valid.size()));
+    REQUIRE(copy.size() == alive.size());
+    for (size_t j = 0; j < copy.size(); ++j) {
+        CHECK(copy[j].same_ids(alive[j]));
+        CHECK(m.is_valid_slow(copy[j]));
+    }
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <wmtk/TetMesh.hpp>
+#include <wmtk/TriMesh.hpp>
+#include <wmtk/invariants/SimplexInversionInvariant.hpp>
+#include <wmtk/utils/orient.hpp>
+#include "predicates.h"
+#include "tools/TetMesh_examples.hpp"
+#include "tools/TriMesh_examples.hpp"
+
+#include <random>
+
+using namespace wmtk;
+
+namespace {
+constexpr PrimitiveType PV = PrimitiveType::Vertex;
+constexpr PrimitiveType PE = PrimitiveType::Edge;
+constexpr PrimitiveType PF = PrimitiveType::Triangle;
+constexpr PrimitiveType PT = PrimitiveType::Tetrahedron;
+
+int exact_sign(double value)
+{
+    return (value > 0) - (value < 0);
+}
+
+// SimplexInversionInvariant::after as it was before it read the connectivity and used the filter
+bool inversion_reference(const TetMesh& m, const attribute::Accessor<double>& acc, const Tuple& t)
+{
+    Eigen::Vector3d p0 = acc.const_vector_attribute<3>(t);
+    Eigen::Vector3d p1 = acc.const_vector_attribute<3>(m.switch_tuple(t, PV));
+    Eigen::Vector3d p2 = acc.const_vector_attribute<3>(m.switch_tuples(t, {PE, PV}));
+    Eigen::Vector3d p3 = acc.const_vector_attribute<3>(m.switch_tuples(t, {PF, PE, PV}));
+    if (m.is_ccw(t)) {
+        return orient3d(p3.data(), p0.data(), p1.data(), p2.data()) > 0;
+    } else {
+        return orient3d(p3.data(), p0.data(), p2.data(), p1.data()) > 0;
+    }
+}
+
+bool inversion_reference(const TriMesh& m, const attribute::Accessor<double>& acc, const Tuple& t)
+{
+    const Tuple ccw = m.is_ccw(t) ? t : m.switch_tuple(t, PV);
+    Eigen::Vector2d p0 = acc.const_vector_attribute<2>(ccw);
+    Eigen::Vector2d p1 = acc.const_vector_attribute<2>(m.switch_tuple(ccw, PV));
+    Eigen::Vector2d p2 = acc.const_vector_attribute<2>(m.switch_tuples(ccw, {PE, PV}));
+    return orient2d(p0.data(), p1.data(), p2.data()) > 0;
+}
+} // namespace
+
+TEST_CASE("orient_filter", "[utils][predicates]")
+{
+    exactinit();
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uniform(-1, 1);
+    std::uniform_int_distribution<int> small_int(-4, 4);
+
+    auto check_3d = [](const Eigen::Vector3d& a,
+                       const Eigen::Vector3d& b,
+                       const Eigen::Vector3d& c,
+                       const Eigen::Vector3d& d) {
+        CHECK(
+            utils::orient3d_sign(a.data(), b.data(), c.data(), d.data()) ==
+            exact_sign(orient3d(a.data(), b.data(), c.data(), d.data())));
+    };
+    auto check_2d = [](const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c) {
+        CHECK(
+            utils::orient2d_sign(a.data(), b.data(), c.data()) ==
+            exact_sign(orient2d(a.data(), b.data(), c.data())));
+    };
+    auto random_3d = [&]() { return Eigen::Vector3d(uniform(gen), uniform(gen), uniform(gen)); };
+    auto random_2d = [&]() { return Eigen::Vector2d(uniform(gen), uniform(gen)); };
+
+    for (int j = 0; j < 1000; ++j) {
+        // generic position
+        check_3d(random_3d(), random_3d(), random_3d(), random_3d());
+        check_2d(random_2d(), random_2d(), random_2d());
+
+        // nearly degenerate, d is on the plane through a, b, c up to rounding
+        const Eigen::Vector3d a = random_3d(), b = random_3d(), c = random_3d();
+        const double s = uniform(gen), t = uniform(gen);
+        const Eigen::Vector3d d = a + s * (b - a) + t * (c - a);
+        check_3d(a, b, c, d);
+        const Eigen::Vector2d a2 = a.head<2>(), b2 = b.head<2>();
+        check_2d(a2, b2, a2 + s * (b2 - a2));
+
+        // exactly degenerate
+        const Eigen::Vector3d ia(small_int(gen), small_int(gen), small_int(gen));
+        const Eigen::Vector3d ib(small_int(gen), small_int(gen), small_int(gen));
+        const Eigen::Vector3d ic(small_int(gen), small_int(gen), small_int(gen));
+        check_3d(ia, ib, ic, ia + 2 * (ib - ia) - (ic - ia));
+        check_2d(ia.head<2>(), ib.head<2>(), ia.head<2>() + 3 * (ib.head<2>() - ia.head<2>()));
+
+        // outside of the range of the filter
+        for (const double scale : {1e-120, 1e120}) {
+            check_3d(scale * a, scale * b, scale * c, scale * random_3d());
+            check_2d(scale * a2, scale * b2, scale * random_2d());
+        }
+    }
+}
+
+TEST_CASE("simplex_inversion_invariant_filter", "[invariants][predicates]")
+{
+    exactinit();
+    std::mt19937 gen(7);
+    // large enough to invert some of the simplices
+    std::uniform_real_distribution<double> noise(-0.4, 0.4);
+
+    SECTION("tet")
+    {
+        TetMesh m = tests_3d::two_by_two_by_two_grids_tets();
+        auto handle = m.register_attribute<double>("vertices", PV, 3);
+        const SimplexInversionInvariant inv(m, handle.as<double>());
+
+        int64_t n_inverted = 0;
+        for (int round = 0; round < 20; ++round) {
+            attribute::Accessor<double> acc = m.create_accessor<double>(handle);
+            int64_t j = 0;
+            for (const Tuple& v : m.get_all(PV)) {
+                acc.vector_attribute(v) = Eigen::Vector3d(j % 3, (j / 3) % 3, j / 9) +
+                                          Eigen::Vector3d(noise(gen), noise(gen), noise(gen));
+                ++j;
+            }
+            for (const Tuple& t : m.get_all(PT)) {
+                for (const Tuple& s :
+                     {t, m.switch_tuple(t, PV), m.switch_tuple(t, PE), m.switch_tuple(t, PF)}) {
+                    const bool expected = inversion_reference(m, acc, s);
+                    CHECK(inv.after({}, {s}) == expected);
+                    n_inverted += !expected;
+                }
+            }
+        }
+        CHECK(n_inverted > 0);
+    }
+    SECTION("tri")
+    {
+        TriMesh m = tests::edge_region();
+        auto handle = m.register_attribute<double>("vertices", PV, 2);
+        const SimplexInversionInvariant inv(m, handle.as<double>());
+
+        int64_t n_inverted = 0;
+        for (int round = 0; round < 20; ++round) {
+            attribute::Accessor<double> acc = m.create_accessor<double>(handle);
+            for (const Tuple& v : m.get_all(PV)) {
+                acc.vector_attribute(v) = Eigen::Vector2d(noise(gen), noise(gen));
+            }
+            for (const Tuple& t : m.get_all(PF)) {
+                for (const Tuple& s : {t, m.switch_tuple(t, PV), m.switch_tuple(t, PE)}) {
+                    const bool expected = inversion_reference(m, acc, s);
+                    CHECK(inv.after({}, {s}) == expected);
+                    n_inverted += !expected;
+                }
+            }
+        }
+        CHECK(n_inverted > 0);
+    }
+}